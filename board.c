@@ -0,0 +1,97 @@
+/** @file board.c
+ *
+ *  @brief The toggle masks and keys of the game grid
+ *
+ *  @author Heather Arthur (harthur)
+ *  @bug None known
+ **/
+
+#include <board.h>
+
+/** @brief the keys of the squares, in bit order
+ *
+ *  Letters come first so grids up to 26 squares use <a-z>, the
+ *  command keys (H, I, N, Q, S, T) are left out.
+ */
+static const char grid_keys[] =
+  "abcdefghijklmnopqrstuvwxyz"
+  "0123456789"
+  "-=[];',./`"
+  "!@#$%^&*()_+{}:\"<>?~|\\"
+  "ABCDEFGJKLMOP";
+
+/* fails to compile if a grid has more squares than keys */
+typedef char grid_keys_fit[(sizeof(grid_keys) - 1 >= GRID_SQUARES) ? 1 : -1];
+
+/** @brief the squares flipped by pressing each square of the grid */
+board_t toggle_masks[GRID_SQUARES];
+
+/* key_squares[ch] is the square whose key is ch, -1 if none */
+static signed char key_squares[128];
+
+/** @brief ors square (row, col) into mask if it is on the grid
+ *
+ *  @param mask the mask to add the square to
+ *  @param row the row of the square
+ *  @param col the column of the square
+ *  @return Void
+ */
+static void add_square(board_t *mask, int row, int col)
+{
+  if(row < 0 || row >= GRID_ROWS || col < 0 || col >= GRID_COLS)
+    return;
+  *mask = board_xor(*mask, board_bit(SQUARE_BIT(row, col)));
+}
+
+/** @brief generates the toggle masks and key table for this grid size
+ *
+ *  Must be called before any board is pressed
+ *
+ *  @param Void
+ *  @return Void
+ */
+void board_init()
+{
+  int sq;
+
+  for(sq = 0; sq < 128; sq++)
+    key_squares[sq] = -1;
+
+  for(sq = 0; sq < GRID_SQUARES; sq++)
+  {
+    int row = SQUARE_ROW(sq);
+    int col = SQUARE_COL(sq);
+    board_t mask = board_zero();
+
+    add_square(&mask, row, col);
+    add_square(&mask, row - 1, col);
+    add_square(&mask, row + 1, col);
+    add_square(&mask, row, col - 1);
+    add_square(&mask, row, col + 1);
+    toggle_masks[sq] = mask;
+
+    key_squares[(int)grid_keys[sq]] = sq;
+  }
+}
+
+/** @brief returns the key that presses square sq
+ *
+ *  @param sq the bit index of the square
+ *  @return the character labelling the square
+ */
+int board_key(int sq)
+{
+  return grid_keys[sq];
+}
+
+/** @brief returns the square pressed by key ch
+ *
+ *  @param ch a character read from the keyboard
+ *  @return the bit index of the square, -1 if ch is not a square key
+ */
+int board_square(int ch)
+{
+  if(ch < 0 || ch >= 128)
+    return -1;
+  return key_squares[ch];
+}
@@ -0,0 +1,108 @@
+/** @file clock.c
+ * 
+ *  @brief A monotonic nanosecond clock built on the time stamp counter
+ *  
+ *  @author Heather Arthur (harthur) 
+ *  @bug Assumes a constant rate time stamp counter
+ **/
+
+#include <clock.h>
+#include <timer_defines.h>
+#include <x86/pio.h>
+#include <pack_address.h>
+
+unsigned int tsc_khz = 0;
+
+/* the multiplier turning cycles into nanoseconds */
+static unsigned int clock_mult = 0;
+/* the cycle count at clock_init, clock_ns() counts from here */
+static unsigned long long clock_base = 0;
+
+/** @brief divides a 64 bit number by a 32 bit one with a single divl
+ *
+ *  The quotient must fit in 32 bits, that is n >> 32 must be less
+ *  than d. This avoids pulling in the libgcc 64 bit division.
+ *
+ *  @param n the dividend
+ *  @param d the divisor
+ *  @return n / d
+ */
+static unsigned int div64_32(unsigned long long n, unsigned int d)
+{
+  unsigned int q, r;
+  __asm__("divl %4"
+	  : "=a" (q), "=d" (r)
+	  : "a" ((unsigned int)n), "d" ((unsigned int)(n >> 32)), "rm" (d));
+  return q;
+}
+
+/** @brief measures the time stamp counter rate against the PIT
+ *
+ *  Runs PIT channel 2 one shot for CALIBRATE_MS with the speaker off
+ *  and counts the cycles until its output goes high. Channel 0 and
+ *  the timer interrupt are not touched.
+ *
+ *  @param Void
+ *  @return Void
+ */
+void clock_init()
+{
+  unsigned int count = TIMER_RATE / 1000 * CALIBRATE_MS;
+  unsigned long long start, end;
+
+  outb(PIT_GATE_IO_PORT,
+       (inb(PIT_GATE_IO_PORT) & ~PIT_GATE_SPEAKER) | PIT_GATE_CH2);
+  outb(TIMER_MODE_IO_PORT, PIT_CH2_ONE_SHOT);
+  outb(PIT_CH2_IO_PORT, LOWER8(count));
+  outb(PIT_CH2_IO_PORT, UPPER8(count));
+
+  start = rdtsc();
+  while(!(inb(PIT_GATE_IO_PORT) & PIT_GATE_OUT2))
+    ;
+  end = rdtsc();
+
+  tsc_khz = (unsigned int)(end - start) / CALIBRATE_MS;
+  clock_mult = div64_32(1000000ULL << CLOCK_SHIFT, tsc_khz);
+  clock_base = end;
+}
+
+/** @brief converts a number of cycles to nanoseconds
+ *
+ *  The high and low words are scaled separately so the product
+ *  never overflows
+ *
+ *  @param cycles a count of time stamp counter cycles
+ *  @return the same time in nanoseconds
+ */
+unsigned long long cycles_to_ns(unsigned long long cycles)
+{
+  unsigned int hi = cycles >> 32;
+  unsigned int lo = cycles;
+
+  return (((unsigned long long)hi * clock_mult) << (32 - CLOCK_SHIFT)) +
+         (((unsigned long long)lo * clock_mult) >> CLOCK_SHIFT);
+}
+
+/** @brief converts a number of cycles to microseconds
+ *
+ *  @param cycles a count of time stamp counter cycles
+ *  @return the same time in microseconds, at most 0xFFFFFFFF
+ */
+unsigned int cycles_to_us(unsigned long long cycles)
+{
+  unsigned long long ns = cycles_to_ns(cycles);
+
+  /* the quotient has to fit in 32 bits */
+  if((ns >> 32) >= 1000)
+    return 0xFFFFFFFF;
+  return div64_32(ns, 1000);
+}
+
+/** @brief returns the time since clock_init() in nanoseconds
+ *
+ *  @return nanoseconds since the clock was calibrated, 0 before
+ */
+unsigned long long clock_ns()
+{
+  return cycles_to_ns(rdtsc() - clock_base);
+}
@@ -7,10 +7,239 @@
 
 #include <console.h>
 #include <pack_address.h>
+#include <mmio.h>
+#include <string.h>
+#include <trace.h>
+
+/* SSE2 fills only in the hosted build (hosted/Makefile defines
+ * HOSTED_BUILD), the kernel does not enable or save SSE state */
+#if defined(__SSE2__) && defined(HOSTED_BUILD)
+#define FILL_SSE2 1
+#include <emmintrin.h>
+#endif
+
+/* the number of character cells on the console */
+#define CONSOLE_CELLS (CONSOLE_WIDTH * CONSOLE_HEIGHT)
+
+/* characters putbyte() does not simply draw */
+#define IS_CONTROL(ch) \
+  ((ch) == '\n' || (ch) == '\r' || (ch) == '\b' || (ch) == '\t')
+
+/* never drawn, since no valid color is 0xFF */
+#define NO_CELLS 0xFFFFFFFF
+
+/* the number of cells of video memory the console can scroll through */
+#define VGA_MEM_CELLS 0x4000
+
+/* video memory, two cells per word */
+#define VGA_PAIRS ((volatile unsigned int *)CONSOLE_MEM_BASE)
+
+/** @brief the cells of the console, addressable in pairs */
+typedef union {
+#ifdef FILL_SSE2
+  __m128i align;
+#endif
+  unsigned short cell[CONSOLE_CELLS];
+  unsigned int pair[CONSOLE_CELLS / 2];
+} screen_t;
+
+/** @brief a console saved by console_save() */
+typedef struct {
+  int used;            /* whether the slot holds a console */
+  screen_t screen;     /* the cells as drawn */
+  int row, col;        /* the real cursor */
+  int color;           /* the terminal color */
+} snapshot_t;
 
 /* the current terminal color code */
 int term_color = FGND_WHITE | BGND_BLACK;
 
+/* the console as drawn, copied to video memory by console_flush() */
+static screen_t shadow;
+/* the console as it was last copied to video memory */
+static screen_t front;
+/* whether front is known to match video memory */
+static int front_valid = 0;
+
+/* the dirty span [dirty_lo, dirty_hi) of each row, clean if empty */
+static unsigned char dirty_lo[CONSOLE_HEIGHT];
+static unsigned char dirty_hi[CONSOLE_HEIGHT];
+/* whether any row has a dirty span */
+static volatile int console_dirty = 0;
+
+/* the cell of video memory shown at the top left of the screen */
+static int origin = 0;
+/* whether scrolling moves origin instead of rewriting the screen */
+static int hw_scrolling = 1;
+/* lines scrolled in shadow since the last flush */
+static int pending_scroll = 0;
+
+/* the cursor position (row is offset by a screen when hidden), only
+ * written to the CRTC by sync_cursor() */
+static int real_row = 0;
+static int real_col = 0;
+/* whether the CRTC cursor is behind real_row and real_col */
+static int cursor_stale = 1;
+
+/* the slots consoles are saved in */
+static snapshot_t snapshots[CONSOLE_SNAPSHOTS];
+
+/** @brief stores pair into n consecutive pairs of cells
+ *
+ *  The widest stores the target has: 16 bytes at a time with SSE2
+ *  in the hosted build, otherwise rep stosl on x86, otherwise a loop.
+ *  dst is one of the in-memory screens, never video memory.
+ *
+ *  @param dst the first pair to store
+ *  @param pair the two cells to store
+ *  @param n the number of pairs
+ *  @return Void
+ */
+static void fill_pairs(unsigned int *dst, unsigned int pair, int n)
+{
+#if defined(FILL_SSE2)
+  __m128i wide = _mm_set1_epi32(pair);
+
+  /* line up on 16 bytes, the screens themselves are */
+  for(; n > 0 && ((unsigned long)dst & 15); n--)
+    *dst++ = pair;
+  for(; n >= 4; n -= 4, dst += 4)
+    _mm_store_si128((__m128i *)dst, wide);
+  while(n-- > 0)
+    *dst++ = pair;
+#elif defined(__i386__)
+  if(n > 0)
+    __asm__ __volatile__("cld; rep stosl"
+			 : "+D" (dst), "+c" (n)
+			 : "a" (pair)
+			 : "memory");
+#else
+  while(n-- > 0)
+    *dst++ = pair;
+#endif
+}
+
+/** @brief adds columns [lo, hi) of row to its dirty span
+ *
+ *  @param row the row drawn to
+ *  @param lo the first column drawn
+ *  @param hi one past the last column drawn
+ *  @return Void
+ */
+static void mark_dirty(int row, int lo, int hi)
+{
+  if(dirty_lo[row] >= dirty_hi[row])
+  {
+    dirty_lo[row] = lo;
+    dirty_hi[row] = hi;
+  }
+  else
+  {
+    if(lo < dirty_lo[row])
+      dirty_lo[row] = lo;
+    if(hi > dirty_hi[row])
+      dirty_hi[row] = hi;
+  }
+  console_dirty = 1;
+}
+
+/** @brief points the CRTC start address at a cell of video memory
+ *
+ *  @param cells the cell to show at the top left of the screen
+ *  @return Void
+ */
+static void set_origin(int cells)
+{
+  origin = cells;
+
+  /* the cursor is relative to the start of video memory */
+  cursor_stale = 1;
+
+  outb(CRTC_IDX_REG, CRTC_START_LSB_IDX);
+  outb(CRTC_DATA_REG, LOWER8(cells));
+  outb(CRTC_IDX_REG, CRTC_START_MSB_IDX);
+  outb(CRTC_DATA_REG, UPPER8(cells));
+}
+
+/** @brief scrolls video memory by moving the CRTC start address
+ *
+ *  Moves origin down by lines, so the rows already in video memory
+ *  scroll without being rewritten and front is shifted to match.
+ *  When origin would run off the end of video memory it goes back
+ *  to 0 and the next flush rewrites the whole screen.
+ *
+ *  @param lines the number of lines scrolled since the last flush
+ *  @return Void
+ */
+static void scroll_origin(int lines)
+{
+  int shift = lines * CONSOLE_WIDTH;
+
+  if(!hw_scrolling || lines <= 0 || lines >= CONSOLE_HEIGHT)
+    return;
+
+  if(origin + shift + CONSOLE_CELLS > VGA_MEM_CELLS)
+  {
+    set_origin(0);
+    front_valid = 0;
+  }
+  else
+  {
+    set_origin(origin + shift);
+    memmove(front.cell, front.cell + shift,
+	    (CONSOLE_CELLS - shift) * sizeof(front.cell[0]));
+
+    /* the rows scrolled into view hold whatever was left there */
+    fill_pairs(front.pair + (CONSOLE_CELLS - shift) / 2, NO_CELLS, shift / 2);
+  }
+}
+
+/** @brief writes a run of ordinary characters at the cursor
+ *
+ *  The run must fit on the line, the cursor moves once to the end
+ *  of it, wrapping to the next line like putbyte().
+ *
+ *  @param row, col position of the current cursor
+ *  @param s the characters to write, none of them control characters
+ *  @param n the number of characters, at most CONSOLE_WIDTH - col
+ *  @return Void
+ */
+static void put_run(int row, int col, const char *s, int n)
+{
+  unsigned short *cell = shadow.cell + row*CONSOLE_WIDTH + col;
+  unsigned short color = (term_color & 0xFF) << 8;
+  int i;
+
+  for(i = 0; i < n; i++)
+    cell[i] = color | (unsigned char)s[i];
+  mark_dirty(row, col, col + n);
+
+  if(col + n >= CONSOLE_WIDTH)
+    nextline(row, col + n - 1);
+  else
+    set_cursor(row, col + n);
+}
+
+/** @brief scrolls the console up one line
+ *
+ *  The top line is lost and the bottom line is cleared in the
+ *  current terminal color
+ *
+ *  @return Void
+ */
+static void scroll_up()
+{
+  int i;
+
+  memmove(shadow.cell, shadow.cell + CONSOLE_WIDTH,
+	  (CONSOLE_CELLS - CONSOLE_WIDTH) * sizeof(shadow.cell[0]));
+  fill_hspan(CONSOLE_HEIGHT - 1, 0, CONSOLE_WIDTH, ' ', term_color);
+
+  for(i = 0; i < CONSOLE_HEIGHT; i++)
+    mark_dirty(i, 0, CONSOLE_WIDTH);
+  pending_scroll++;
+}
+
 int putbyte( char ch )
 {
   /* get the current location of the cursor */
@@ -44,14 +273,7 @@ void nextline(int row, int col)
   /* scroll if necessary */
   if(row == (CONSOLE_HEIGHT - 1))
   {
-    int i, j, k;
-    for(i = 0; i < CONSOLE_HEIGHT - 1; i++)
-    	for(j = 0; j < CONSOLE_WIDTH ; j++)
-		draw_char(i,j, get_char(i + 1, j), get_char_color(i + 1, j));
-
-    for(k = 0; k < CONSOLE_WIDTH; k++)
-      draw_char(CONSOLE_HEIGHT - 1, k, ' ', term_color);
-
+    scroll_up();
     set_cursor(row, 0);
   }
  
@@ -85,9 +307,31 @@ putbytes( const char *s, int len )
   if(!s || len <= 0)
     return;
 
-  int i; 
-  for(i = 0; i < len; i++)
-    putbyte(*(s + i));
+  int i = 0; 
+  while(i < len)
+  {
+    int row, col, n;
+    get_cursor(&row, &col);
+
+    /* the run of ordinary characters that fits on this line */
+    int room = CONSOLE_WIDTH - col;
+    if(room > len - i)
+      room = len - i;
+    for(n = 0; n < room && !IS_CONTROL(s[i + n]); n++)
+      ;
+
+    /* control characters keep the putbyte behavior */
+    if(n == 0)
+    {
+      putbyte(s[i++]);
+      continue;
+    }
+
+    put_run(row, col, s + i, n);
+    i += n;
+  }
+
+  sync_cursor();
 }
 
 int
@@ -110,16 +354,9 @@ get_term_color( int *color )
 
 int set_real_cursor(int row, int col)
 {
-  int offset = row * CONSOLE_WIDTH + col;
-
-  /* send lower order bits of offset */
-  outb(CRTC_IDX_REG, CRTC_CURSOR_LSB_IDX);
-  outb(CRTC_DATA_REG, LOWER8(offset));
-
-  /* send higher order bits of offset */
-  outb(CRTC_IDX_REG, CRTC_CURSOR_MSB_IDX);
-  outb(CRTC_DATA_REG, UPPER8(offset));
-
+  real_row = row;
+  real_col = col;
+  cursor_stale = 1;
   return 0;
 }
 
@@ -128,19 +365,27 @@ int get_real_cursor(int *row, int *col)
   if(!row || !col)
     return -1;
 
-  /* get lower order bits of offset */
+  *row = real_row;
+  *col = real_col;
+  return 0;
+}
+
+void
+sync_cursor()
+{
+  if(!cursor_stale)
+    return;
+  cursor_stale = 0;
+
+  int offset = origin + real_row * CONSOLE_WIDTH + real_col;
+
+  /* send lower order bits of offset */
   outb(CRTC_IDX_REG, CRTC_CURSOR_LSB_IDX);
-  int low_off  = inb(CRTC_DATA_REG);
-  
-  /* get higher order bits of offset */
-  outb(CRTC_IDX_REG, CRTC_CURSOR_MSB_IDX);
-  int high_off = inb(CRTC_DATA_REG);
-  
-  int offset = low_off | (high_off << 8);
-  *col = offset % CONSOLE_WIDTH;
-  *row = offset / CONSOLE_WIDTH;
+  outb(CRTC_DATA_REG, LOWER8(offset));
 
-  return 0;
+  /* send higher order bits of offset */
+  outb(CRTC_IDX_REG, CRTC_CURSOR_MSB_IDX);
+  outb(CRTC_DATA_REG, UPPER8(offset));
 }
 
 int
@@ -206,10 +451,7 @@ void
 clear_console()
 {
   /* fill every row with spaces  */
-  int i, j;
-  for(i = 0; i < CONSOLE_HEIGHT; i++)
-     for(j = 0; j < CONSOLE_WIDTH ; j++)
-	draw_char(i,j, ' ', term_color);
+  fill_rect(0, 0, CONSOLE_HEIGHT, CONSOLE_WIDTH, ' ', term_color);
 
   set_cursor(0,0);
 }
@@ -220,20 +462,193 @@ draw_char( int row, int col, int ch, int color )
   if(!is_point(row,col) || !is_color(color))
     return;
 
-  *(char *)(CONSOLE_MEM_BASE + row*(CONSOLE_WIDTH * 2) + col*2) = ch;
-  *(char *)(CONSOLE_MEM_BASE + row*(CONSOLE_WIDTH * 2) + col*2 + 1) = color;  
+  draw_char_fast(row, col, ch, color);
+}
+
+void
+draw_char_fast( int row, int col, int ch, int color )
+{
+  shadow.cell[row*CONSOLE_WIDTH + col] = CELL(ch, color);
+  mark_dirty(row, col, col + 1);
+}
+
+void
+fill_hspan( int row, int col, int n, int ch, int color )
+{
+  unsigned short cell = CELL(ch, color);
+  unsigned int pair = ((unsigned int)cell << 16) | cell;
+  int i = row*CONSOLE_WIDTH + col;
+  int end = i + n;
+
+  if(n <= 0)
+    return;
+  mark_dirty(row, col, col + n);
+
+  /* a cell on either side of the whole pairs */
+  if(i & 1)
+    shadow.cell[i++] = cell;
+  if(end & 1)
+    shadow.cell[--end] = cell;
+
+  fill_pairs(shadow.pair + i / 2, pair, (end - i) / 2);
+}
+
+void
+fill_vspan( int row, int col, int n, int ch, int color )
+{
+  unsigned short cell = CELL(ch, color);
+  int i;
+
+  for(i = 0; i < n; i++)
+  {
+    shadow.cell[(row + i)*CONSOLE_WIDTH + col] = cell;
+    mark_dirty(row + i, col, col + 1);
+  }
+}
+
+void
+fill_rect( int row, int col, int rows, int cols, int ch, int color )
+{
+  unsigned short cell = CELL(ch, color);
+  int i;
+
+  if(cols != CONSOLE_WIDTH)
+  {
+    for(i = 0; i < rows; i++)
+      fill_hspan(row + i, col, cols, ch, color);
+    return;
+  }
+
+  /* whole rows are one run of pairs */
+  fill_pairs(shadow.pair + row*(CONSOLE_WIDTH / 2),
+	     ((unsigned int)cell << 16) | cell, rows*(CONSOLE_WIDTH / 2));
+  for(i = 0; i < rows; i++)
+    mark_dirty(row + i, 0, CONSOLE_WIDTH);
+}
+
+void
+draw_cells( int row, int col, const unsigned short *cells, int n )
+{
+  unsigned short *cell = shadow.cell + row*CONSOLE_WIDTH + col;
+  int i;
+
+  for(i = 0; i < n; i++)
+    cell[i] = cells[i];
+  mark_dirty(row, col, col + n);
 }
 
 char
 get_char( int row, int col )
 {
-  return *(char *)(CONSOLE_MEM_BASE + row*(CONSOLE_WIDTH * 2) + col*2);
+  return shadow.cell[row*CONSOLE_WIDTH + col] & 0xFF;
 }
 
 char
 get_char_color(int row, int col)
 {
-  return *(char *)(CONSOLE_MEM_BASE + row*(CONSOLE_WIDTH * 2) + col*2 + 1);
+  return shadow.cell[row*CONSOLE_WIDTH + col] >> 8;
+}
+
+void
+console_flush()
+{
+  int row, i;
+
+  scroll_origin(pending_scroll);
+  pending_scroll = 0;
+
+  /* nothing is known about video memory yet, so write every cell */
+  if(!front_valid)
+  {
+    fill_pairs(front.pair, NO_CELLS, CONSOLE_CELLS / 2);
+    for(row = 0; row < CONSOLE_HEIGHT; row++)
+      mark_dirty(row, 0, CONSOLE_WIDTH);
+    set_origin(origin);
+    front_valid = 1;
+  }
+
+  sync_cursor();
+
+  if(!console_dirty)
+    return;
+  console_dirty = 0;
+
+  int rows = 0, written = 0;
+  for(row = 0; row < CONSOLE_HEIGHT; row++)
+  {
+    /* widen the span to whole pairs of cells */
+    int lo = dirty_lo[row] / 2;
+    int hi = (dirty_hi[row] + 1) / 2;
+    if(lo >= hi)
+      continue;
+    dirty_lo[row] = dirty_hi[row] = 0;
+    rows++;
+
+    /* only pairs that differ from video memory are written */
+    for(i = row*(CONSOLE_WIDTH / 2) + lo; i < row*(CONSOLE_WIDTH / 2) + hi; i++)
+      if(shadow.pair[i] != front.pair[i])
+      {
+	front.pair[i] = shadow.pair[i];
+	mmio_write32(VGA_PAIRS + origin / 2 + i, shadow.pair[i]);
+	written++;
+      }
+  }
+  TRACE(TR_FLUSH, written, rows);
+}
+
+int
+console_save()
+{
+  int slot;
+
+  for(slot = 0; slot < CONSOLE_SNAPSHOTS; slot++)
+    if(!snapshots[slot].used)
+      break;
+  if(slot == CONSOLE_SNAPSHOTS)
+    return -1;
+
+  snapshots[slot].used = 1;
+  memcpy(&snapshots[slot].screen, &shadow, sizeof(shadow));
+  snapshots[slot].row = real_row;
+  snapshots[slot].col = real_col;
+  snapshots[slot].color = term_color;
+  return slot;
+}
+
+int
+console_restore(int slot)
+{
+  int row;
+
+  if(slot < 0 || slot >= CONSOLE_SNAPSHOTS || !snapshots[slot].used)
+    return -1;
+
+  snapshots[slot].used = 0;
+  memcpy(&shadow, &snapshots[slot].screen, sizeof(shadow));
+  set_real_cursor(snapshots[slot].row, snapshots[slot].col);
+  term_color = snapshots[slot].color;
+
+  /* the flush only writes the pairs that differ from video memory */
+  for(row = 0; row < CONSOLE_HEIGHT; row++)
+    mark_dirty(row, 0, CONSOLE_WIDTH);
+  return 0;
+}
+
+void
+hw_scroll(int enable)
+{
+  if(enable)
+  {
+    hw_scrolling = 1;
+    return;
+  }
+
+  /* go back to the start of video memory, rewriting the screen there */
+  hw_scrolling = 0;
+  pending_scroll = 0;
+  set_origin(0);
+  front_valid = 0;
+  console_flush();
 }
 
 int 
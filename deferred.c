@@ -0,0 +1,46 @@
+/** @file deferred.c
+ * 
+ *  @brief Runs work posted by interrupt handlers from the main loop
+ *  
+ *  @author Heather Arthur (harthur) 
+ *  @bug None known
+ **/
+
+#include <deferred.h>
+
+volatile unsigned int deferred_pending = 0;
+
+/* the handler for each kind of work, indexed by bit number */
+static void (*handlers[DEFER_KINDS])(void);
+
+/** @brief sets the function run for a kind of deferred work
+ *
+ *  @param work the DEFER_ bit of the work
+ *  @param handler the function to run when the work is posted
+ *  @return Void
+ */
+void defer_handler(unsigned int work, void (*handler)(void))
+{
+  int i;
+  for(i = 0; i < DEFER_KINDS; i++)
+    if(work == (1u << i))
+      handlers[i] = handler;
+}
+
+/** @brief runs the handler of every kind of work posted
+ *
+ *  Must not be called from interrupt context. Work posted several
+ *  times since the last call runs once.
+ *
+ *  @return Void
+ */
+void run_deferred()
+{
+  /* take everything posted so far in one atomic exchange */
+  unsigned int work = __sync_lock_test_and_set(&deferred_pending, 0);
+  int i;
+
+  for(i = 0; work; i++, work >>= 1)
+    if((work & 1) && handlers[i])
+      handlers[i]();
+}
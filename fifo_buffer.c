@@ -3,32 +3,42 @@
  *  @brief Functions to manipulate the keyboard buffer
  *  
  *  @author Heather Arthur (harthur) 
- *  @bug If the buffer is full, characters will be lost 
+ *  @bug If the buffer is full, new scancodes are dropped (and counted)
  **/
 
 #include <fifo_buffer.h>
 
 
-int head = 0;
-int tail = 0;
+volatile unsigned int head = 0;
+volatile unsigned int tail = 0;
+volatile unsigned int dropped = 0;
 
 /** @brief the keyboard buffer */
-char buffer[BUFF_SIZE];
+unsigned char buffer[BUFF_SIZE];
 
 /** @brief Queues a scancode in the keyboard buffer 
  *
  *  Adds a buffer item for this scancode to the end of the
- *    keyboard queue
+ *    keyboard queue. If the queue is full the scancode is dropped,
+ *    unread scancodes are never overwritten.
  *
  *  @param scancode - the scancode to queue
  *  @return Void
  */
 void enqueue_char(int scancode)
 {
-  buffer[head] = scancode;
-  head++;
-  if(head == BUFF_SIZE)
-    head = 0;
+  unsigned int h = head;
+  if(h - tail == BUFF_SIZE)
+  {
+    dropped++;
+    return;
+  }
+
+  buffer[h & BUFF_MASK] = scancode;
+
+  /* the scancode must be in the buffer before the consumer sees it */
+  barrier();
+  head = h + 1;
 }
 
 /** @brief Dequeues the top scancode in the keyboard buffer 
@@ -37,15 +47,47 @@ void enqueue_char(int scancode)
  *    item in queue)
  *
  *  @param none
- *  @return the scancode of the head of the queue 
+ *  @return the scancode of the head of the queue, -1 if it is empty
  */
 int dequeue_char()
 {
-  if(head == tail)
+  unsigned int t = tail;
+  if(t == head)
     return -1;
-  int next_code = buffer[tail];
-  tail++;
-  if(tail == BUFF_SIZE)
-    tail = 0;
+
+  /* read the scancode only after seeing head, and before freeing it */
+  barrier();
+  int next_code = buffer[t & BUFF_MASK];
+  barrier();
+
+  tail = t + 1;
   return next_code;
 }
+
+/** @brief Dequeues up to n scancodes from the keyboard buffer
+ *
+ *  Takes everything pending, up to n, with a single update of tail
+ *
+ *  @param codes where the scancodes are written, oldest first
+ *  @param n the most scancodes to dequeue
+ *  @return the number of scancodes dequeued
+ */
+int dequeue_n(unsigned char *codes, int n)
+{
+  unsigned int t = tail;
+  unsigned int count = head - t;
+  unsigned int i;
+
+  if(n <= 0 || !count)
+    return 0;
+  if(count > (unsigned int)n)
+    count = n;
+
+  barrier();
+  for(i = 0; i < count; i++)
+    codes[i] = buffer[(t + i) & BUFF_MASK];
+  barrier();
+
+  tail = t + count;
+  return count;
+}
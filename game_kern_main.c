@@ -33,6 +33,10 @@
 /* for playing the game */
 #include <game_play.h>
 
+/* for the timer mode and clock */
+#include <timer.h>
+#include <clock.h>
+
 /*
  * state for kernel memory allocation.
  */
@@ -74,6 +78,16 @@ int kernel_main()
 
     handler_install(tick);
 
+    /*
+     * only take timer interrupts when the game time needs them
+     */
+    timer_tickless(1);
+
+    /*
+     * calibrate the nanosecond clock against the PIT
+     */
+    clock_init();
+
     /*
      * initialize the PIC so that IRQs and
      * exception handlers don't overlap in the IDT.
@@ -7,21 +7,37 @@
  **/
 
 #include <410_reqs.h>
+#include <board.h>
 #include <paint_screen.h>
+#include <solver.h>
 #include <game_play.h>
 #include <console.h>
+#include <readchar.h>
+#include <deferred.h>
+#include <trace.h>
+#include <irq_stats.h>
+#include <replay.h>
+#include <puzzle_table.h>
 #include <rand.h>
 #include <time.h>
 
-/** @brief an upper bound on the number of moves needed to win */
+/* whether the puzzle table was generated for this grid */
+#define USE_PUZZLES (PUZZLE_ROWS == GRID_ROWS && PUZZLE_COLS == GRID_COLS)
+
+/** @brief the random presses making a grid with no puzzle table */
 #define GAME_DEPTH 10
 
 /* the state of the game */
-int grid[5][5];
+board_t board;
 int moves;
 int wins;
 int losses;
 
+/* a solution of board, kept up to date on every press */
+board_t solution;
+/* the square highlighted as a hint, -1 if none */
+int hint_sq = -1;
+
 /** @brief the main loop of the program
  *  
  *  If a key is pressed that is not associated with
@@ -31,30 +47,86 @@ int losses;
  */
 void game_run()
 {
+  key_event_t ev;
+
+  board_init();
+  solver_init();
+  paint_init();
+  defer_handler(DEFER_TIME, show_time);
   hide_cursor();
   handle_new();
   can_tick = 1;
 
   while(1)
   {
-    int ch = readchar();
-    if(ch > 0)
-    {
-      if(ch >= 'a' && ch <= 'y')
-      {
-	handle_char((char)ch);
-	if(is_win())
-	  handle_win();
-      }
-      else if(ch == 'N')
-	handle_loss();
-      else if(ch ==  'I')
-	handle_ins();
-      else if(ch == 'Q')
-	handle_new();
-    }
+    run_deferred();
+    console_flush();
+    if(!wait_for_event(&ev, 1))
+      continue;
+
+    /* every key decoded so far is handled before the next flush, one
+     * at a time, so keys behind one that changes screens stay queued
+     * for the wait_key() of the new screen */
+    do
+      handle_key(ev.ch);
+    while(next_events(&ev, 1));
+  }
+}
 
+/** @brief handles one key press on the game screen
+ *
+ *  @param ch the character pressed
+ *  @return Void
+ */
+void handle_key(int ch)
+{
+  if(ch == 'N')
+    handle_loss();
+  else if(ch ==  'I')
+    handle_ins();
+  else if(ch == 'Q')
+    handle_new();
+  else if(ch == 'S')
+    handle_diag();
+  else if(ch == 'T')
+    handle_trace();
+  else if(ch == 'H')
+    handle_hint();
+  else if(board_square(ch) >= 0)
+  {
+    handle_char((char)ch);
+    if(is_win())
+      handle_win();
+  }
+}
+
+/** @brief idles until any key is pressed
+ *
+ *  @return the key pressed
+ */
+int wait_key()
+{
+  key_event_t ev;
+
+  do
+  {
+    run_deferred();
+    console_flush();
   }
+  while(!wait_for_event(&ev, 1));
+
+  return ev.ch;
+}
+
+/** @brief paints the game time, run as deferred work after a tick
+ *
+ *  @return Void
+ */
+void show_time()
+{
+  /* the time may have been posted just before the game screen left */
+  if(can_tick)
+    update_time(game_time);
 }
 
 /** @brief handles displaying/logging a win
@@ -69,9 +141,7 @@ void handle_win()
   wins++;
   win_screen();
   
-  while(1) 
-    if((int)readchar() > 0)
-	break;
+  wait_key();
   new_game();
   can_tick = 1;
 }
@@ -90,17 +160,50 @@ void handle_loss()
   can_tick = 1;
 }
 
-/** @brief handles the press of an a-y character key
+/** @brief handles the press of the key of a square
  *  
  *  @return Void
  */
 void handle_char(char ch)
 {
+  clear_hint();
   toggle_char(ch);
   moves++;
+  TRACE(TR_CHAR, ch, moves);
   paint_stats(moves, wins, losses);
 }
 
+/** @brief highlights the next square to press
+ *
+ *  The cached solution is only brought down to the fewest presses
+ *  here, so a keypress pays for nothing but a single XOR.
+ *
+ *  @return Void
+ */
+void handle_hint()
+{
+  clear_hint();
+  if(board_empty(solution))
+    return;
+
+  solution = solver_minimize(solution);
+  hint_sq = board_first(solution);
+  paint_square(SQUARE_ROW(hint_sq), SQUARE_COL(hint_sq),
+	       board_test(board, hint_sq) | SQUARE_HINT);
+}
+
+/** @brief removes the hint highlight from the grid, if any
+ *
+ *  @return Void
+ */
+void clear_hint()
+{
+  if(hint_sq < 0)
+    return;
+  paint_squares(board, board_bit(hint_sq));
+  hint_sq = -1;
+}
+
 /** @brief the setup of a completely new game
  *  
  *  @param Void
@@ -111,9 +214,7 @@ void handle_new()
   can_tick = 0;
   title_screen();
 
-  while(1) 
-    if((int)readchar() > 0)
-	break;
+  wait_key();
 
   game_time = 0;
   moves = 0;
@@ -133,11 +234,52 @@ void handle_ins()
   can_tick = 0;
   ins_screen();
 
-  while(1) 
-    if((int)readchar() > 0)
-	break;
+  wait_key();
 
-  game_screen(grid, moves, wins, losses);
+  hint_sq = -1;
+  game_screen(board, moves, wins, losses);
+  can_tick = 1;
+}
+
+/** @brief handles displaying the interrupt statistics screen
+ *
+ *  Pressing C on the statistics screen clears them
+ *  
+ *  @param Void
+ *  @return Void
+ */
+void handle_diag()
+{
+  can_tick = 0;
+  diag_screen();
+  if(wait_key() == 'C')
+    irq_stats_reset();
+
+  hint_sq = -1;
+  game_screen(board, moves, wins, losses);
+  can_tick = 1;
+}
+
+/** @brief handles displaying the event trace screen
+ *
+ *  Pressing D on the trace screen also dumps the trace to the
+ *  serial port, R dumps the input recorded since startup
+ *  
+ *  @param Void
+ *  @return Void
+ */
+void handle_trace()
+{
+  can_tick = 0;
+  trace_screen();
+  int ch = wait_key();
+  if(ch == 'D')
+    trace_dump_serial();
+  else if(ch == 'R')
+    replay_dump_serial();
+
+  hint_sq = -1;
+  game_screen(board, moves, wins, losses);
   can_tick = 1;
 }
 
@@ -149,26 +291,44 @@ void handle_ins()
 void new_game()
 {
   generate_grid();
-  game_screen(grid, moves, wins, losses);
+  solve(board, &solution);
+  hint_sq = -1;
+  game_screen(board, moves, wins, losses);
+  update_time(game_time);
 }
 
 /** @brief generates a winnable starting grid
  *  
+ *  Picks a random board from the puzzle table, from the tier of
+ *  difficulty the player's record (wins less losses) has reached.
+ *  Grids the table was not generated for get random presses instead.
+ *
  *  @param Void
  *  @return Void
  */
 void generate_grid()
 {
   initialize_grid();
-  sgenrand(total_time);
+  sgenrand(REPLAY_SEED(total_time));
   int i;
 
-  /* just do series of toggles on random squares */
+#if USE_PUZZLES
+  int tier = wins - losses;
+  if(tier < 0)
+    tier = 0;
+  else if(tier >= PUZZLE_TIERS)
+    tier = PUZZLE_TIERS - 1;
+
+  const unsigned int *puzzle = puzzle_table[puzzle_start[tier] +
+    genrand() % (puzzle_start[tier + 1] - puzzle_start[tier])];
+  for(i = 0; i < BOARD_WORDS; i++)
+    board.w[i] = puzzle[i];
+#else
+  /* just do series of presses on random squares, the screen is
+   * painted once the whole grid is ready */
   for(i = 0; i < GAME_DEPTH; i++)
-  {
-    unsigned long square = (genrand() % 25) + 97;
-    toggle_char(square);
-  }
+    board = BOARD_PRESS(board, genrand() % GRID_SQUARES);
+#endif
 }
 
 /** @brief turns all squares off in grid
@@ -178,10 +338,7 @@ void generate_grid()
  */
 void initialize_grid()
 {
-  int i, j;
-  for(i = 0; i < 5; i++)
-    for(j = 0; j < 5; j++)
-      grid[i][j] = 0;
+  board = board_zero();
 }
 
 /** @brief toggles the squares associated with this character
@@ -196,46 +353,18 @@ void initialize_grid()
  */
 void toggle_char(char ch)
 {
-  int row = TOROW(ch);
-  int col = TOCOL(ch);
+  int sq = board_square(ch);
 
-  toggle_square(row, col);
-
-  if(row)
-    toggle_square(row - 1, col);
-  if(row != 4)
-    toggle_square(row + 1, col);
-  if(col)
-    toggle_square(row, col - 1);
-  if(col != 4)
-    toggle_square(row, col + 1);
-}
-
-/** @brief toggles a square
- *  
- *  Flips the color of the square at (row,col) in the grid
- *
- *  @param row the row in the grid of the square
- *  @param col the column in the grid of the square
- *  @return Void
- */
-void toggle_square(int row, int col)
-{
-  grid[row][col] = !(grid[row][col]);
-  paint_square(row, col, grid[row][col]);
+  board = BOARD_PRESS(board, sq);
+  solution = board_xor(solution, board_bit(sq));
+  paint_squares(board, toggle_masks[sq]);
 }
 
 /** @brief returns whether the grid is in a win state
  *  
- *  @param ch the character associated with the square to toggle
  *  @return non-zero if win
  */
 int is_win()
 {  
-  int i, j;
-  for(i = 0; i < 5; i++)
-    for(j = 0; j < 5; j++)
-      if(grid[i][j] == 1)
-	return 0;
-  return 1;
+  return board_empty(board);
 }
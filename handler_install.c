@@ -17,15 +17,14 @@
 #include <x86/pio.h>
 #include <common.h>
 #include <pack_address.h>
+#include <tickback_addr.h>
+#include <timer.h>
 
 int handler_install(void (*tickback)(unsigned int numTicks))
 {
-  /* set timer mode */
-  outb(TIMER_MODE_IO_PORT, TIMER_SQUARE_WAVE);
-
-  /* set the timer period */
-  outb(TIMER_PERIOD_IO_PORT, LOWER8(TIMER_RATE / 100));
-  outb(TIMER_PERIOD_IO_PORT, UPPER8(TIMER_RATE / 100));
+  /* set timer mode and period */
+  tickback_addr = tickback;
+  timer_set_hz(TICK_HZ);
  
   /* install timer handler */
   long long *timer_idt = (long long *)sidt() + TIMER_IDT_ENTRY;
@@ -0,0 +1,239 @@
+/** @file bench.c
+ *  @brief Microbenchmarks of the console, painting and game hot paths
+ *
+ *  Usage: bench [-t ms] [-j] [name ...]
+ *
+ *  Each benchmark repeats one operation followed by console_flush(),
+ *  as the main loop does, in doubling batches until it has run for at
+ *  least ms milliseconds (200 by default). It reports the time and
+ *  cycles per operation and the video memory stores and port I/O the
+ *  simulated machine saw per operation. With -j each result is printed
+ *  as a line of JSON instead, for comparing runs. Names select which
+ *  benchmarks run, all of them by default.
+ *
+ *  @author Heather Arthur (harthur)
+ *  @bug None known
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <x86/proc_reg.h>
+#include <console.h>
+#include <paint_screen.h>
+#include <game_play.h>
+#include <solver.h>
+#include <clock.h>
+#include "sim.h"
+
+/* the default least time each benchmark runs */
+#define DEFAULT_MS 200
+
+/* the first batch size */
+#define FIRST_BATCH 16
+
+/** @brief a benchmark, op is run with the iteration number */
+typedef struct {
+  const char *name;
+  void (*op)(unsigned int i);
+} bench_t;
+
+/* printf draws on the console, results go through fprintf */
+
+/* text putbytes is run with, longer than any run */
+static char text[CONSOLE_WIDTH * CONSOLE_HEIGHT];
+
+/* boards the grid benchmarks alternate between */
+static board_t boards[2];
+
+/* keeps is_win from being optimized away */
+static volatile int win_sink;
+
+/* the operations, each is given the iteration number */
+
+static void op_draw_char(unsigned int i)
+{
+  draw_char(i % CONSOLE_HEIGHT, (i * 7) % CONSOLE_WIDTH,
+	    'a' + i % 26, DEFAULT_COLOR);
+}
+
+static void op_putbyte(unsigned int i)
+{
+  putbyte('a' + i % 26);
+}
+
+static void op_putbytes_8(unsigned int i)
+{
+  putbytes(text + i % 26, 8);
+}
+
+static void op_putbytes_80(unsigned int i)
+{
+  putbytes(text + i % 26, CONSOLE_WIDTH);
+}
+
+static void op_putbytes_400(unsigned int i)
+{
+  putbytes(text + i % 26, 5 * CONSOLE_WIDTH);
+}
+
+static void op_nextline(unsigned int i)
+{
+  nextline(CONSOLE_HEIGHT - 1, 0);
+}
+
+static void op_clear_console(unsigned int i)
+{
+  clear_console();
+}
+
+static void op_paint_square(unsigned int i)
+{
+  paint_square(SQUARE_ROW(i % GRID_SQUARES), SQUARE_COL(i % GRID_SQUARES),
+	       (i / GRID_SQUARES) & 1);
+}
+
+static void op_paint_grid(unsigned int i)
+{
+  paint_grid(boards[i & 1]);
+}
+
+static void op_game_screen(unsigned int i)
+{
+  game_screen(boards[i & 1], i, 0, 0);
+}
+
+static void op_toggle_char(unsigned int i)
+{
+  toggle_char(board_key(i % GRID_SQUARES));
+}
+
+static void op_is_win(unsigned int i)
+{
+  win_sink = is_win();
+}
+
+static const bench_t benches[] = {
+  { "draw_char", op_draw_char },
+  { "putbyte", op_putbyte },
+  { "putbytes_8", op_putbytes_8 },
+  { "putbytes_80", op_putbytes_80 },
+  { "putbytes_400", op_putbytes_400 },
+  { "nextline_scroll", op_nextline },
+  { "clear_console", op_clear_console },
+  { "paint_square", op_paint_square },
+  { "paint_grid", op_paint_grid },
+  { "game_screen", op_game_screen },
+  { "toggle_char", op_toggle_char },
+  { "is_win", op_is_win },
+};
+
+#define NBENCHES ((int)(sizeof(benches) / sizeof(benches[0])))
+
+/** @brief runs one benchmark and prints its result
+ *
+ *  @param b the benchmark
+ *  @param min_ns the least time to run it for
+ *  @param json whether to print JSON
+ *  @return Void
+ */
+static void run(const bench_t *b, unsigned long long min_ns, int json)
+{
+  unsigned long long ops = 0, ns = 0, cycles = 0, mmio = 0, pio = 0;
+  unsigned int batch = FIRST_BATCH;
+
+  /* start every benchmark from the same screen */
+  clear_console();
+  console_flush();
+
+  while(ns < min_ns)
+  {
+    unsigned long long mmio0 = sim_mmio_writes;
+    unsigned long long pio0 = sim_pio_reads + sim_pio_writes;
+    unsigned long long t0 = clock_ns(), c0 = rdtsc();
+    unsigned int i;
+
+    for(i = 0; i < batch; i++)
+    {
+      b->op(ops + i);
+      console_flush();
+    }
+
+    cycles += rdtsc() - c0;
+    ns += clock_ns() - t0;
+    mmio += sim_mmio_writes - mmio0;
+    pio += sim_pio_reads + sim_pio_writes - pio0;
+    ops += batch;
+    batch *= 2;
+  }
+
+  if(json)
+    fprintf(stdout, "{\"bench\":\"%s\",\"ops\":%llu,\"ns_per_op\":%.2f,"
+	   "\"cycles_per_op\":%.2f,\"mmio_per_op\":%.3f,\"pio_per_op\":%.3f}\n",
+	   b->name, ops, (double)ns / ops, (double)cycles / ops,
+	   (double)mmio / ops, (double)pio / ops);
+  else
+    fprintf(stdout, "%-16s %10llu %12.2f %12.2f %10.3f %10.3f\n",
+	   b->name, ops, (double)ns / ops, (double)cycles / ops,
+	   (double)mmio / ops, (double)pio / ops);
+}
+
+/** @brief sets up the game as game_run() does and runs the benchmarks
+ *
+ *  @return 0 on success, 1 if a benchmark name is unknown
+ */
+int main(int argc, char **argv)
+{
+  unsigned long long min_ns = DEFAULT_MS * 1000000ULL;
+  int json = 0, picked = 0;
+  int i, j;
+
+  for(i = 1; i < argc; i++)
+  {
+    if(!strcmp(argv[i], "-t") && i + 1 < argc)
+      min_ns = atoi(argv[++i]) * 1000000ULL;
+    else if(!strcmp(argv[i], "-j"))
+      json = 1;
+    else
+    {
+      for(j = 0; j < NBENCHES && strcmp(argv[i], benches[j].name); j++)
+	;
+      if(j == NBENCHES)
+      {
+	fprintf(stderr, "%s: no benchmark %s\n", argv[0], argv[i]);
+	return 1;
+      }
+      picked = 1;
+    }
+  }
+
+  for(i = 0; i < (int)sizeof(text); i++)
+    text[i] = 'a' + i % 26;
+
+  clock_init();
+  enable_interrupts();
+  board_init();
+  solver_init();
+  paint_init();
+  hide_cursor();
+  new_game();
+  boards[0] = board_zero();
+  boards[1] = board_full();
+
+  if(!json)
+    fprintf(stdout, "%-16s %10s %12s %12s %10s %10s\n",
+	   "benchmark", "ops", "ns/op", "cycles/op", "mmio/op", "pio/op");
+
+  for(j = 0; j < NBENCHES; j++)
+  {
+    if(picked)
+    {
+      for(i = 1; i < argc && strcmp(argv[i], benches[j].name); i++)
+	;
+      if(i == argc)
+	continue;
+    }
+    run(&benches[j], min_ns, json);
+  }
+  return 0;
+}
@@ -0,0 +1,14 @@
+/** @file 410_reqs.h
+ *
+ *  @brief hosted stand-in for the 15-410 required interface
+ *
+ *  @author Heather Arthur (harthur)
+ */
+
+#ifndef __HOSTED_410_REQS_H
+#define __HOSTED_410_REQS_H
+
+int handler_install(void (*tickback)(unsigned int));
+int readchar(void);
+
+#endif
@@ -0,0 +1,21 @@
+/** @file cpu.h
+ *
+ *  @brief replaces the halt of the kernel cpu.h
+ *
+ *  Halting runs the simulated machine until its next interrupt has
+ *  been delivered, see sim_idle().
+ *
+ *  @author Heather Arthur (harthur)
+ */
+
+#ifndef __HOSTED_CPU_H
+#define __HOSTED_CPU_H
+
+#define halt_for_interrupt kernel_halt_for_interrupt
+#include_next <cpu.h>
+#undef halt_for_interrupt
+
+void sim_idle();
+#define halt_for_interrupt sim_idle
+
+#endif
@@ -0,0 +1,14 @@
+/** @file interrupts.h
+ *
+ *  @brief hosted stand-in for the PIC port definitions
+ *
+ *  @author Heather Arthur (harthur)
+ */
+
+#ifndef __HOSTED_INTERRUPTS_H
+#define __HOSTED_INTERRUPTS_H
+
+#define INT_CTL_REG 0x20
+#define INT_CTL_DONE 0x20
+
+#endif
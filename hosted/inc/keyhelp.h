@@ -0,0 +1,32 @@
+/** @file keyhelp.h
+ *
+ *  @brief hosted stand-in for the scancode decoder
+ *
+ *  Decodes scancode set 1 for a US layout with shift, which covers
+ *  every key the game uses. See keyhelp.c.
+ *
+ *  @author Heather Arthur (harthur)
+ */
+
+#ifndef __HOSTED_KEYHELP_H
+#define __HOSTED_KEYHELP_H
+
+#define KEYBOARD_PORT 0x60
+#define KEY_IDT_ENTRY 0x21
+
+/* the decoded key, a character and flags */
+typedef int kh_type;
+
+#define KH_HASDATA_FLAG 0x100
+#define KH_ISMAKE_FLAG 0x200
+
+#define KH_HASDATA(k) ((k) & KH_HASDATA_FLAG)
+#define KH_ISMAKE(k) ((k) & KH_ISMAKE_FLAG)
+#define KH_GETCHAR(k) ((k) & 0xFF)
+
+kh_type process_scancode(int keypress);
+
+/* only in the hosted build, the scancodes that type ch */
+int keyhelp_encode(int ch, unsigned char *codes);
+
+#endif
@@ -0,0 +1,34 @@
+/** @file mmio.h
+ *
+ *  @brief counts the device memory writes of the kernel mmio.h
+ *
+ *  @author Heather Arthur (harthur)
+ */
+
+#ifndef __HOSTED_MMIO_H
+#define __HOSTED_MMIO_H
+
+#define mmio_write16 kernel_mmio_write16
+#define mmio_write32 kernel_mmio_write32
+#include_next <mmio.h>
+#undef mmio_write16
+#undef mmio_write32
+
+/* the number of stores to video memory, see sim.h */
+extern unsigned long long sim_mmio_writes;
+
+/** @brief writes a 16 bit value to device memory and counts it */
+static inline void mmio_write16(volatile void *addr, unsigned short val)
+{
+  sim_mmio_writes++;
+  kernel_mmio_write16(addr, val);
+}
+
+/** @brief writes a 32 bit value to device memory and counts it */
+static inline void mmio_write32(volatile void *addr, unsigned int val)
+{
+  sim_mmio_writes++;
+  kernel_mmio_write32(addr, val);
+}
+
+#endif
@@ -0,0 +1,14 @@
+/** @file rand.h
+ *
+ *  @brief hosted stand-in for the kernel random number generator
+ *
+ *  @author Heather Arthur (harthur)
+ */
+
+#ifndef __HOSTED_RAND_H
+#define __HOSTED_RAND_H
+
+void sgenrand(unsigned long seed);
+unsigned long genrand(void);
+
+#endif
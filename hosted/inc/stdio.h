@@ -0,0 +1,19 @@
+/** @file stdio.h
+ *
+ *  @brief routes printf to the console, as the kernel libc does
+ *
+ *  Everything else comes from the host C library. Host output goes
+ *  through fprintf or fputs.
+ *
+ *  @author Heather Arthur (harthur)
+ */
+
+#ifndef __HOSTED_STDIO_H
+#define __HOSTED_STDIO_H
+
+#include_next <stdio.h>
+
+int console_printf(const char *fmt, ...);
+#define printf console_printf
+
+#endif
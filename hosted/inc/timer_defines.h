@@ -0,0 +1,17 @@
+/** @file timer_defines.h
+ *
+ *  @brief hosted stand-in for the PIT definitions
+ *
+ *  @author Heather Arthur (harthur)
+ */
+
+#ifndef __HOSTED_TIMER_DEFINES_H
+#define __HOSTED_TIMER_DEFINES_H
+
+#define TIMER_RATE 1193182
+#define TIMER_IDT_ENTRY 0x20
+#define TIMER_PERIOD_IO_PORT 0x40
+#define TIMER_MODE_IO_PORT 0x43
+#define TIMER_SQUARE_WAVE 0x36
+
+#endif
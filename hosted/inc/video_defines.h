@@ -0,0 +1,50 @@
+/** @file video_defines.h
+ *
+ *  @brief hosted stand-in for the VGA text mode definitions
+ *
+ *  Video memory is an array in the simulated machine, see sim.h.
+ *
+ *  @author Heather Arthur (harthur)
+ */
+
+#ifndef __HOSTED_VIDEO_DEFINES_H
+#define __HOSTED_VIDEO_DEFINES_H
+
+extern unsigned short sim_vram[];
+
+#define CONSOLE_MEM_BASE ((unsigned long)sim_vram)
+#define CONSOLE_WIDTH 80
+#define CONSOLE_HEIGHT 25
+
+#define CRTC_IDX_REG 0x3d4
+#define CRTC_DATA_REG 0x3d5
+#define CRTC_CURSOR_LSB_IDX 15
+#define CRTC_CURSOR_MSB_IDX 14
+
+#define FGND_BLACK 0x0
+#define FGND_BLUE  0x1
+#define FGND_GREEN 0x2
+#define FGND_CYAN  0x3
+#define FGND_RED   0x4
+#define FGND_MAG   0x5
+#define FGND_BRWN  0x6
+#define FGND_LGRAY 0x7
+#define FGND_DGRAY 0x8
+#define FGND_BBLUE 0x9
+#define FGND_BGRN  0xA
+#define FGND_BCYAN 0xB
+#define FGND_PINK  0xC
+#define FGND_BMAG  0xD
+#define FGND_YLLW  0xE
+#define FGND_WHITE 0xF
+
+#define BGND_BLACK 0x00
+#define BGND_BLUE  0x10
+#define BGND_GREEN 0x20
+#define BGND_CYAN  0x30
+#define BGND_RED   0x40
+#define BGND_MAG   0x50
+#define BGND_BRWN  0x60
+#define BGND_LGRAY 0x70
+
+#endif
@@ -0,0 +1,14 @@
+/** @file pio.h
+ *
+ *  @brief hosted stand-in for port I/O, handled by the simulated machine
+ *
+ *  @author Heather Arthur (harthur)
+ */
+
+#ifndef __HOSTED_PIO_H
+#define __HOSTED_PIO_H
+
+unsigned char inb(unsigned short port);
+void outb(unsigned short port, unsigned char val);
+
+#endif
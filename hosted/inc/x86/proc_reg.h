@@ -0,0 +1,14 @@
+/** @file proc_reg.h
+ *
+ *  @brief hosted stand-in for the interrupt flag controls
+ *
+ *  @author Heather Arthur (harthur)
+ */
+
+#ifndef __HOSTED_PROC_REG_H
+#define __HOSTED_PROC_REG_H
+
+void enable_interrupts(void);
+void disable_interrupts(void);
+
+#endif
@@ -0,0 +1,106 @@
+/** @file keyhelp.c
+ *
+ *  @brief A scancode set 1 decoder standing in for the kernel's
+ *
+ *  Knows the US layout of the main keys and both shift keys, prefixed
+ *  (0xE0) keys are skipped.
+ *
+ *  @author Heather Arthur (harthur)
+ *  @bug Caps lock and control are not decoded
+ **/
+
+#include <keyhelp.h>
+
+/* make codes of the shift keys, break codes are make | KEY_BREAK */
+#define KEY_LSHIFT 0x2A
+#define KEY_RSHIFT 0x36
+#define KEY_BREAK 0x80
+#define KEY_PREFIX 0xE0
+
+/* the number of make codes in the tables */
+#define KEY_CODES 0x3A
+
+/* the character of each make code, unshifted and shifted */
+static const char plain[KEY_CODES + 1] =
+  "\0\033" "1234567890-=\b"
+  "\tqwertyuiop[]\n"
+  "\0asdfghjkl;'`"
+  "\0\\zxcvbnm,./\0"
+  "*\0 ";
+static const char shifted[KEY_CODES + 1] =
+  "\0\033" "!@#$%^&*()_+\b"
+  "\tQWERTYUIOP{}\n"
+  "\0ASDFGHJKL:\"~"
+  "\0|ZXCVBNM<>?\0"
+  "*\0 ";
+
+/* whether each shift key is down */
+static int lshift = 0;
+static int rshift = 0;
+/* whether the last scancode was the extended prefix */
+static int prefixed = 0;
+
+/** @brief decodes one scancode
+ *
+ *  @param keypress the scancode read from the keyboard
+ *  @return the decoded key, KH_HASDATA is clear for modifiers
+ */
+kh_type process_scancode(int keypress)
+{
+  int code = keypress & ~KEY_BREAK;
+  int make = !(keypress & KEY_BREAK);
+  char ch;
+
+  if(keypress == KEY_PREFIX)
+  {
+    prefixed = 1;
+    return 0;
+  }
+  if(prefixed)
+  {
+    prefixed = 0;
+    return 0;
+  }
+
+  if(code == KEY_LSHIFT)
+    lshift = make;
+  else if(code == KEY_RSHIFT)
+    rshift = make;
+  if(code >= KEY_CODES)
+    return 0;
+
+  ch = (lshift || rshift) ? shifted[code] : plain[code];
+  if(!ch)
+    return 0;
+  return KH_HASDATA_FLAG | (make ? KH_ISMAKE_FLAG : 0) | (unsigned char)ch;
+}
+
+/** @brief finds the scancodes that type a character
+ *
+ *  @param ch the character
+ *  @param codes where up to four scancodes are written
+ *  @return the number of scancodes, 0 if no key types ch
+ */
+int keyhelp_encode(int ch, unsigned char *codes)
+{
+  int code, n = 0;
+
+  for(code = 1; code < KEY_CODES; code++)
+    if(plain[code] == ch)
+    {
+      codes[n++] = code;
+      codes[n++] = code | KEY_BREAK;
+      return n;
+    }
+
+  for(code = 1; code < KEY_CODES; code++)
+    if(shifted[code] == ch)
+    {
+      codes[n++] = KEY_LSHIFT;
+      codes[n++] = code;
+      codes[n++] = code | KEY_BREAK;
+      codes[n++] = KEY_LSHIFT | KEY_BREAK;
+      return n;
+    }
+  return 0;
+}
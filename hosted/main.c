@@ -0,0 +1,130 @@
+/** @file main.c
+ *  @brief Runs the game as a Linux program on the simulated machine
+ *
+ *  Usage: lightsout [-g gap_ms] [-s scancode_file] [-w log] [keys ...]
+ *
+ *  Each argument is typed on the simulated keyboard, gap_ms apart
+ *  (100 by default), after the scancodes of scancode_file if given.
+ *  When every key has been handled the screen is printed to standard
+ *  output, and with -w the recorded input is written to log for
+ *  playback. The serial port writes to standard error.
+ *
+ *  @author Heather Arthur (harthur)
+ *  @bug None known
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <410_reqs.h>
+#include <x86/proc_reg.h>
+#include <game_play.h>
+#include <timer.h>
+#include <clock.h>
+#include <replay.h>
+#include "sim.h"
+
+/* the time between typed keys, in milliseconds */
+#define DEFAULT_GAP_MS 100
+
+extern void tick(unsigned int numTicks);
+
+/* where the recorded input is written, if anywhere */
+static const char *log_path = NULL;
+
+/** @brief writes the recorded input to log_path
+ *
+ *  @return 0 on success, -1 on failure
+ */
+static int write_log()
+{
+  unsigned char hdr[REPLAY_HDR_SIZE];
+  FILE *f = fopen(log_path, "wb");
+  int ok;
+
+  if(!f)
+    return -1;
+  replay_header(hdr, replay_len);
+  ok = fwrite(hdr, 1, REPLAY_HDR_SIZE, f) == REPLAY_HDR_SIZE &&
+       fwrite(replay_log, 1, replay_len, f) == replay_len;
+  return (fclose(f) == 0 && ok) ? 0 : -1;
+}
+
+/** @brief prints the final screen, writes the log and exits
+ *
+ *  @return Does not return
+ */
+static void show_screen()
+{
+  sim_screen(stdout);
+  if(log_path && write_log() < 0)
+  {
+    fprintf(stderr, "cannot write %s\n", log_path);
+    exit(1);
+  }
+  exit(0);
+}
+
+/** @brief queues the scancodes of a file
+ *
+ *  @param path the file of raw scancodes
+ *  @param gap_ms the time between scancodes
+ *  @return 0 on success, -1 on failure
+ */
+static int load_scancodes(const char *path, unsigned int gap_ms)
+{
+  FILE *f = fopen(path, "rb");
+  int code;
+
+  if(!f)
+    return -1;
+  while((code = fgetc(f)) != EOF)
+    if(sim_scancode(code, gap_ms) < 0)
+    {
+      fclose(f);
+      return -1;
+    }
+  fclose(f);
+  return 0;
+}
+
+/** @brief queues the input and starts the game as kernel_main does
+ *
+ * @return Does not return
+ */
+int main(int argc, char **argv)
+{
+  unsigned int gap_ms = DEFAULT_GAP_MS;
+  int i;
+
+  for(i = 1; i < argc; i++)
+  {
+    if(!strcmp(argv[i], "-g") && i + 1 < argc)
+      gap_ms = atoi(argv[++i]);
+    else if(!strcmp(argv[i], "-w") && i + 1 < argc)
+      log_path = argv[++i];
+    else if(!strcmp(argv[i], "-s") && i + 1 < argc)
+    {
+      if(load_scancodes(argv[++i], gap_ms) < 0)
+      {
+        fprintf(stderr, "%s: cannot queue %s\n", argv[0], argv[i]);
+        return 1;
+      }
+    }
+    else if(sim_type(argv[i], gap_ms) < 0)
+    {
+      fprintf(stderr, "%s: cannot type %s\n", argv[0], argv[i]);
+      return 1;
+    }
+  }
+  sim_on_drained(show_screen);
+
+  handler_install(tick);
+  timer_tickless(1);
+  clock_init();
+  enable_interrupts();
+  game_run();
+
+  show_screen();
+  return 0;
+}
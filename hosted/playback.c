@@ -0,0 +1,139 @@
+/** @file playback.c
+ *  @brief Replays a recorded input log through the game at full speed
+ *
+ *  Usage: playback [-l loops] [-f hash_file] [-n] log
+ *
+ *  The log comes from lightsout -w or from the kernel's serial dump
+ *  (R on the trace screen). It is played loops times (once by
+ *  default) through the keyboard handler and tick(), with the game
+ *  started as kernel_main does. The screen is hashed each time the
+ *  game halts, with -f each frame's hash is written to hash_file,
+ *  and -n turns the hashing off. At the end it prints the keystrokes
+ *  (scancodes) and frames per second and the hash of all frames, which
+ *  only stays the same if the game draws exactly the same screens.
+ *
+ *  @author Heather Arthur (harthur)
+ *  @bug None known
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <410_reqs.h>
+#include <x86/proc_reg.h>
+#include <board.h>
+#include <game_play.h>
+#include <timer.h>
+#include <clock.h>
+#include <replay.h>
+#include "sim.h"
+
+extern void tick(unsigned int numTicks);
+
+/* the records of the log */
+static unsigned char *recs;
+/* clock_ns() when the game started */
+static unsigned long long start_ns;
+
+/** @brief prints the results and exits
+ *
+ *  @return Does not return
+ */
+static void report()
+{
+  unsigned long long ns = clock_ns() - start_ns;
+  double secs = ns / 1e9;
+
+  fprintf(stdout, "scancodes %llu frames %llu seconds %.3f\n",
+	  sim_keys, sim_frames, secs);
+  fprintf(stdout, "scancodes/s %.0f frames/s %.0f\n",
+	  sim_keys / secs, sim_frames / secs);
+  if(sim_hash_frames)
+    fprintf(stdout, "hash %016llx\n", sim_hash);
+  if(sim_hash_out)
+    fclose(sim_hash_out);
+  exit(0);
+}
+
+/** @brief reads a log file
+ *
+ *  @param path the log file
+ *  @param len where the length of its records is written
+ *  @return the records, NULL if the file is not a log of this build
+ */
+static unsigned char *read_log(const char *path, unsigned int *len)
+{
+  unsigned char hdr[REPLAY_HDR_SIZE];
+  unsigned char *buf = NULL;
+  FILE *f = fopen(path, "rb");
+
+  if(!f)
+    return NULL;
+  if(fread(hdr, 1, REPLAY_HDR_SIZE, f) == REPLAY_HDR_SIZE &&
+     replay_check_header(hdr, len) == 0 &&
+     (buf = malloc(*len ? *len : 1)) != NULL &&
+     fread(buf, 1, *len, f) != *len)
+  {
+    free(buf);
+    buf = NULL;
+  }
+  fclose(f);
+  return buf;
+}
+
+/** @brief plays a log through the game
+ *
+ *  @return 0 on success, 1 on bad arguments or log
+ */
+int main(int argc, char **argv)
+{
+  const char *path = NULL;
+  unsigned int len;
+  int loops = 1;
+  int i;
+
+  sim_hash_frames = 1;
+  for(i = 1; i < argc; i++)
+  {
+    if(!strcmp(argv[i], "-l") && i + 1 < argc)
+      loops = atoi(argv[++i]);
+    else if(!strcmp(argv[i], "-f") && i + 1 < argc)
+    {
+      if(!(sim_hash_out = fopen(argv[++i], "w")))
+      {
+	fprintf(stderr, "%s: cannot write %s\n", argv[0], argv[i]);
+	return 1;
+      }
+    }
+    else if(!strcmp(argv[i], "-n"))
+      sim_hash_frames = 0;
+    else
+      path = argv[i];
+  }
+
+  if(!path)
+  {
+    fprintf(stderr, "usage: %s [-l loops] [-f hash_file] [-n] log\n", argv[0]);
+    return 1;
+  }
+
+  handler_install(tick);
+  if(!(recs = read_log(path, &len)))
+  {
+    fprintf(stderr, "%s: %s is not a log for a %dx%d grid\n",
+	    argv[0], path, GRID_ROWS, GRID_COLS);
+    return 1;
+  }
+
+  sim_replay(recs, len, loops);
+  sim_on_drained(report);
+  timer_tickless(1);
+  clock_init();
+  enable_interrupts();
+
+  start_ns = clock_ns();
+  game_run();
+
+  report();
+  return 0;
+}
@@ -0,0 +1,36 @@
+/** @file printf.c
+ *
+ *  @brief printf for the game, drawn on the console as in the kernel
+ *
+ *  @author Heather Arthur (harthur)
+ *  @bug Output longer than PRINTF_MAX characters is cut off
+ **/
+
+#include <stdio.h>
+#include <stdarg.h>
+#include <console.h>
+
+/* the longest output of one call */
+#define PRINTF_MAX 256
+
+/** @brief formats a string and prints it at the cursor
+ *
+ *  @param fmt the format
+ *  @return the number of characters printed
+ */
+int console_printf(const char *fmt, ...)
+{
+  char buf[PRINTF_MAX];
+  va_list ap;
+  int len;
+
+  va_start(ap, fmt);
+  len = vsnprintf(buf, sizeof(buf), fmt, ap);
+  va_end(ap);
+
+  if(len >= (int)sizeof(buf))
+    len = sizeof(buf) - 1;
+  if(len > 0)
+    putbytes(buf, len);
+  return len;
+}
@@ -0,0 +1,581 @@
+/** @file puzzlegen.c
+ *  @brief Generates the table of starting boards, rated by difficulty
+ *
+ *  Usage: puzzlegen [-j threads] [-k per_tier] [-t tiers] [-m min_presses]
+ *                   [-s samples] [-o dir]
+ *
+ *  A board is rated by the length of its minimal solution. Grids of up
+ *  to ENUM_MAX_SQUARES squares are rated exhaustively, larger ones from
+ *  samples random boards. The presses from min_presses (a third of the
+ *  longest solution by default) to the longest are split into tiers,
+ *  and each tier keeps per_tier boards: those with the smallest hash,
+ *  so the choice is uniform but the same however the work was split.
+ *  The boards of a tier are sorted and have no duplicates.
+ *
+ *  The work is cut into chunks dealt out to one deque per thread. A
+ *  thread takes chunks from the back of its own deque and, once that is
+ *  empty, steals from the front of another's.
+ *
+ *  The table is written as dir/puzzle_table.c and dir/inc/puzzle_table.h
+ *  (.. by default, the kernel tree). Build with GRID=n for other sizes.
+ *
+ *  @author Heather Arthur (harthur)
+ *  @bug None known
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <board.h>
+#include <solver.h>
+
+/* the largest grid every board of is rated */
+#define ENUM_MAX_SQUARES 28
+
+/* the number of boards rated exhaustively, 0 if they are sampled */
+#if GRID_SQUARES <= ENUM_MAX_SQUARES
+#define ENUM_BOARDS (1ULL << GRID_SQUARES)
+#else
+#define ENUM_BOARDS 0ULL
+#endif
+
+/* boards (or samples) per chunk of work */
+#define CHUNK_BITS 16
+#define CHUNK_SIZE (1u << CHUNK_BITS)
+
+/* the defaults of the options */
+#define DEFAULT_PER_TIER 256
+#define DEFAULT_TIERS 4
+#define DEFAULT_SAMPLES (1u << 24)
+
+/* the longest a minimal solution can be */
+#define MAX_PRESSES GRID_SQUARES
+
+/** @brief a board and the hash that orders the choice */
+typedef struct {
+  unsigned long long hash;
+  board_t board;
+} cand_t;
+
+/** @brief the candidates with the smallest hashes, a max heap */
+typedef struct {
+  int n;
+  cand_t *c;
+} heap_t;
+
+/** @brief a range of chunks, taken from both ends */
+typedef struct {
+  pthread_mutex_t lock;
+  unsigned int front;
+  unsigned int back;
+} deque_t;
+
+/** @brief the state of one thread */
+typedef struct {
+  pthread_t thread;
+  int id;
+  unsigned long long count[MAX_PRESSES + 1];   /* boards by presses */
+  heap_t keep[MAX_PRESSES + 1];                /* chosen by presses */
+  unsigned int chunks;                         /* chunks done */
+  unsigned int stolen;                         /* of those, stolen */
+} worker_t;
+
+static int nthreads;
+static int per_tier = DEFAULT_PER_TIER;
+static int enumerate;
+static unsigned long long samples = DEFAULT_SAMPLES;
+static unsigned int nchunks;
+
+static deque_t *deques;
+static worker_t *workers;
+
+/** @brief mixes a 64 bit number, splitmix64's finalizer
+ *
+ *  @param x the number
+ *  @return the mixed number
+ */
+static unsigned long long mix(unsigned long long x)
+{
+  x ^= x >> 30;
+  x *= 0xbf58476d1ce4e5b9ULL;
+  x ^= x >> 27;
+  x *= 0x94d049bb133111ebULL;
+  return x ^ (x >> 31);
+}
+
+/** @brief hashes a board
+ *
+ *  @param b the board
+ *  @return its hash
+ */
+static unsigned long long board_hash(board_t b)
+{
+  unsigned long long h = 0;
+  int i;
+
+  for(i = 0; i < BOARD_WORDS; i++)
+    h = mix(h ^ b.w[i] ^ ((unsigned long long)i << 32));
+  return h;
+}
+
+/** @brief compares two boards word by word, highest word first
+ *
+ *  @return <0, 0 or >0 as a is less than, equal to or more than b
+ */
+static int board_cmp(const board_t *a, const board_t *b)
+{
+  int i;
+
+  for(i = BOARD_WORDS - 1; i >= 0; i--)
+    if(a->w[i] != b->w[i])
+      return a->w[i] < b->w[i] ? -1 : 1;
+  return 0;
+}
+
+/** @brief orders candidates by hash, then board */
+static int cand_cmp(const void *a, const void *b)
+{
+  const cand_t *x = a, *y = b;
+
+  if(x->hash != y->hash)
+    return x->hash < y->hash ? -1 : 1;
+  return board_cmp(&x->board, &y->board);
+}
+
+/** @brief orders candidates by board */
+static int cand_board_cmp(const void *a, const void *b)
+{
+  return board_cmp(&((const cand_t *)a)->board, &((const cand_t *)b)->board);
+}
+
+/** @brief offers a board to a heap, keeping the per_tier smallest hashes
+ *
+ *  @param h the heap
+ *  @param b the board
+ *  @return Void
+ */
+static void heap_offer(heap_t *h, board_t b)
+{
+  cand_t x;
+  int i, child;
+
+  x.hash = board_hash(b);
+  x.board = b;
+
+  if(h->n == per_tier)
+  {
+    if(cand_cmp(&x, &h->c[0]) >= 0)
+      return;
+
+    /* samples can repeat a board, which must not be kept twice */
+    if(!enumerate)
+      for(i = 0; i < h->n; i++)
+        if(h->c[i].hash == x.hash && !board_cmp(&h->c[i].board, &b))
+          return;
+
+    /* replace the largest and sift it down */
+    for(i = 0; (child = 2 * i + 1) < h->n; i = child)
+    {
+      if(child + 1 < h->n && cand_cmp(&h->c[child + 1], &h->c[child]) > 0)
+        child++;
+      if(cand_cmp(&h->c[child], &x) <= 0)
+        break;
+      h->c[i] = h->c[child];
+    }
+    h->c[i] = x;
+    return;
+  }
+
+  if(!enumerate)
+    for(i = 0; i < h->n; i++)
+      if(h->c[i].hash == x.hash && !board_cmp(&h->c[i].board, &b))
+        return;
+
+  /* add at the bottom and sift it up */
+  for(i = h->n++; i > 0 && cand_cmp(&h->c[(i - 1) / 2], &x) < 0; i = (i - 1) / 2)
+    h->c[i] = h->c[(i - 1) / 2];
+  h->c[i] = x;
+}
+
+/** @brief returns board number n, its bits are the bits of n
+ *
+ *  @param n the board number, less than 2 ^ GRID_SQUARES
+ *  @return the board
+ */
+static board_t board_number(unsigned long long n)
+{
+  board_t b = board_zero();
+  int i;
+
+  for(i = 0; i < BOARD_WORDS && i < 2; i++)
+    b.w[i] = n >> (32 * i);
+  return b;
+}
+
+/** @brief returns a random board made by pressing random squares
+ *
+ *  @param state the generator state
+ *  @return a solvable board
+ */
+static board_t random_board(unsigned long long *state)
+{
+  board_t b = board_zero();
+  int i;
+
+  for(i = 0; i < BOARD_WORDS; i++)
+  {
+    *state += 0x9e3779b97f4a7c15ULL;
+    unsigned long long r = mix(*state);
+    b.w[i] = r;
+  }
+  b.w[BOARD_WORDS - 1] &= BOARD_LAST_BITS;
+
+  /* any set of presses is a solution of some board */
+  board_t lit = board_zero();
+  for(i = 0; i < GRID_SQUARES; i++)
+    if(board_test(b, i))
+      lit = BOARD_PRESS(lit, i);
+  return lit;
+}
+
+/** @brief rates every board of one chunk
+ *
+ *  @param w the thread doing it
+ *  @param chunk the chunk number
+ *  @return Void
+ */
+static void run_chunk(worker_t *w, unsigned int chunk)
+{
+  unsigned long long i;
+
+  if(enumerate)
+  {
+    unsigned long long first = (unsigned long long)chunk << CHUNK_BITS;
+    unsigned long long last = first + CHUNK_SIZE;
+    if(last > ENUM_BOARDS)
+      last = ENUM_BOARDS;
+
+    for(i = first; i < last; i++)
+    {
+      board_t b = board_number(i);
+      int presses = solve(b, NULL);
+      if(presses < 0)
+        continue;
+      w->count[presses]++;
+      heap_offer(&w->keep[presses], b);
+    }
+  }
+  else
+  {
+    /* each chunk has its own seed, so samples do not depend on the
+     * thread that takes the chunk */
+    unsigned long long state = mix(chunk + 1);
+    unsigned long long first = (unsigned long long)chunk << CHUNK_BITS;
+
+    for(i = first; i < first + CHUNK_SIZE && i < samples; i++)
+    {
+      board_t b = random_board(&state);
+      int presses = solve(b, NULL);
+      w->count[presses]++;
+      heap_offer(&w->keep[presses], b);
+    }
+  }
+}
+
+/** @brief takes a chunk, from the back of the thread's own deque or
+ *         else from the front of another's
+ *
+ *  @param w the thread
+ *  @param chunk where the chunk number is written
+ *  @return 0 if a chunk was taken, -1 if no work is left
+ */
+static int take_chunk(worker_t *w, unsigned int *chunk)
+{
+  deque_t *d = &deques[w->id];
+  int i, got = 0;
+
+  pthread_mutex_lock(&d->lock);
+  if(d->front < d->back)
+  {
+    *chunk = --d->back;
+    got = 1;
+  }
+  pthread_mutex_unlock(&d->lock);
+  if(got)
+    return 0;
+
+  for(i = 1; i < nthreads; i++)
+  {
+    deque_t *v = &deques[(w->id + i) % nthreads];
+    pthread_mutex_lock(&v->lock);
+    if(v->front < v->back)
+    {
+      *chunk = v->front++;
+      got = 1;
+    }
+    pthread_mutex_unlock(&v->lock);
+    if(got)
+    {
+      w->stolen++;
+      return 0;
+    }
+  }
+  return -1;
+}
+
+/** @brief runs chunks until there are none left anywhere
+ *
+ *  @param arg the worker_t of the thread
+ *  @return NULL
+ */
+static void *work(void *arg)
+{
+  worker_t *w = arg;
+  unsigned int chunk;
+
+  while(take_chunk(w, &chunk) == 0)
+  {
+    run_chunk(w, chunk);
+    w->chunks++;
+  }
+  return NULL;
+}
+
+/** @brief writes the table as C source
+ *
+ *  @param dir the kernel tree
+ *  @param tier the boards of each tier, sorted
+ *  @param tier_n the number of boards of each tier
+ *  @param tier_lo the fewest presses of each tier
+ *  @param tiers the number of tiers
+ *  @return 0 on success, -1 on failure
+ */
+static int write_table(const char *dir, cand_t **tier, int *tier_n,
+                       int *tier_lo, int tiers)
+{
+  char path[4096];
+  FILE *f;
+  int t, i, j, start = 0;
+
+  snprintf(path, sizeof(path), "%s/inc/puzzle_table.h", dir);
+  if(!(f = fopen(path, "w")))
+    return -1;
+  fprintf(f,
+    "/** @file puzzle_table.h\n"
+    " *\n"
+    " *  @brief contains the table of starting boards\n"
+    " *\n"
+    " *  Generated by hosted/puzzlegen, do not edit. The boards of tier t\n"
+    " *  are puzzle_table[puzzle_start[t]] up to puzzle_start[t + 1], each\n"
+    " *  needs at least puzzle_presses[t] presses. Tiers are in order of\n"
+    " *  difficulty.\n"
+    " *\n"
+    " *  @author Heather Arthur (harthur)\n"
+    " */\n\n"
+    "#ifndef __PUZZLE_TABLE_H\n"
+    "#define __PUZZLE_TABLE_H\n\n"
+    "/* the grid the table was generated for */\n"
+    "#define PUZZLE_ROWS %d\n"
+    "#define PUZZLE_COLS %d\n"
+    "/* the 32 bit words of each board */\n"
+    "#define PUZZLE_WORDS %d\n"
+    "/* the number of difficulty tiers */\n"
+    "#define PUZZLE_TIERS %d\n\n"
+    "extern const unsigned int puzzle_table[][PUZZLE_WORDS];\n"
+    "extern const unsigned short puzzle_start[PUZZLE_TIERS + 1];\n"
+    "extern const unsigned char puzzle_presses[PUZZLE_TIERS];\n\n"
+    "#endif\n",
+    GRID_ROWS, GRID_COLS, BOARD_WORDS, tiers);
+  if(fclose(f))
+    return -1;
+
+  snprintf(path, sizeof(path), "%s/puzzle_table.c", dir);
+  if(!(f = fopen(path, "w")))
+    return -1;
+  fprintf(f,
+    "/** @file puzzle_table.c\n"
+    " *\n"
+    " *  @brief The starting boards of a %dx%d grid, by difficulty\n"
+    " *\n"
+    " *  Generated by hosted/puzzlegen, do not edit.\n"
+    " *\n"
+    " *  @author Heather Arthur (harthur)\n"
+    " *  @bug None known\n"
+    " **/\n\n"
+    "#include <puzzle_table.h>\n\n",
+    GRID_ROWS, GRID_COLS);
+
+  fprintf(f, "const unsigned char puzzle_presses[PUZZLE_TIERS] = {");
+  for(t = 0; t < tiers; t++)
+    fprintf(f, "%s%d", t ? ", " : " ", tier_lo[t]);
+  fprintf(f, " };\n\n");
+
+  fprintf(f, "const unsigned short puzzle_start[PUZZLE_TIERS + 1] = {");
+  for(t = 0; t <= tiers; t++)
+  {
+    fprintf(f, "%s%d", t ? ", " : " ", start);
+    if(t < tiers)
+      start += tier_n[t];
+  }
+  fprintf(f, " };\n\n");
+
+  fprintf(f, "const unsigned int puzzle_table[][PUZZLE_WORDS] = {\n");
+  for(t = 0; t < tiers; t++)
+  {
+    fprintf(f, "  /* tier %d, %d or more presses */\n", t, tier_lo[t]);
+    for(i = 0; i < tier_n[t]; i++)
+    {
+      fprintf(f, "%s{", i % 4 ? " " : "  ");
+      for(j = 0; j < BOARD_WORDS; j++)
+        fprintf(f, "%s0x%08x", j ? ", " : " ", tier[t][i].board.w[j]);
+      fprintf(f, " },%s", (i % 4 == 3 || i == tier_n[t] - 1) ? "\n" : "");
+    }
+  }
+  fprintf(f, "};\n");
+  return fclose(f) ? -1 : 0;
+}
+
+/** @brief rates the boards and writes the table
+ *
+ *  @return 0 on success, 1 on failure
+ */
+int main(int argc, char **argv)
+{
+  const char *dir = "..";
+  int tiers = DEFAULT_TIERS, min_presses = -1;
+  unsigned long long count[MAX_PRESSES + 1];
+  cand_t *tier[MAX_PRESSES + 1];
+  int tier_n[MAX_PRESSES + 1], tier_lo[MAX_PRESSES + 2];
+  int i, p, t, longest = 0;
+
+  nthreads = sysconf(_SC_NPROCESSORS_ONLN);
+  for(i = 1; i < argc; i++)
+  {
+    if(!strcmp(argv[i], "-j") && i + 1 < argc)
+      nthreads = atoi(argv[++i]);
+    else if(!strcmp(argv[i], "-k") && i + 1 < argc)
+      per_tier = atoi(argv[++i]);
+    else if(!strcmp(argv[i], "-t") && i + 1 < argc)
+      tiers = atoi(argv[++i]);
+    else if(!strcmp(argv[i], "-m") && i + 1 < argc)
+      min_presses = atoi(argv[++i]);
+    else if(!strcmp(argv[i], "-s") && i + 1 < argc)
+      samples = strtoull(argv[++i], NULL, 0);
+    else if(!strcmp(argv[i], "-o") && i + 1 < argc)
+      dir = argv[++i];
+    else
+    {
+      fprintf(stderr, "usage: %s [-j threads] [-k per_tier] [-t tiers] "
+              "[-m min_presses] [-s samples] [-o dir]\n", argv[0]);
+      return 1;
+    }
+  }
+  if(nthreads < 1)
+    nthreads = 1;
+  /* puzzle_start is 16 bits */
+  if(per_tier < 1 || tiers < 1 || tiers > MAX_PRESSES ||
+     (long long)per_tier * tiers > 0xFFFF)
+  {
+    fprintf(stderr, "%s: bad tier options\n", argv[0]);
+    return 1;
+  }
+
+  board_init();
+  solver_init();
+
+  enumerate = ENUM_BOARDS != 0;
+  if(enumerate)
+    nchunks = (ENUM_BOARDS + CHUNK_SIZE - 1) >> CHUNK_BITS;
+  else
+    nchunks = (samples + CHUNK_SIZE - 1) >> CHUNK_BITS;
+
+  /* deal the chunks out in equal runs, stealing evens out the rest */
+  deques = calloc(nthreads, sizeof(deque_t));
+  workers = calloc(nthreads, sizeof(worker_t));
+  for(i = 0; i < nthreads; i++)
+  {
+    pthread_mutex_init(&deques[i].lock, NULL);
+    deques[i].front = (unsigned long long)nchunks * i / nthreads;
+    deques[i].back = (unsigned long long)nchunks * (i + 1) / nthreads;
+    workers[i].id = i;
+    for(p = 0; p <= MAX_PRESSES; p++)
+      workers[i].keep[p].c = malloc(per_tier * sizeof(cand_t));
+  }
+
+  for(i = 0; i < nthreads; i++)
+    pthread_create(&workers[i].thread, NULL, work, &workers[i]);
+  for(i = 0; i < nthreads; i++)
+    pthread_join(workers[i].thread, NULL);
+
+  memset(count, 0, sizeof(count));
+  for(i = 0; i < nthreads; i++)
+  {
+    for(p = 0; p <= MAX_PRESSES; p++)
+      count[p] += workers[i].count[p];
+    fprintf(stderr, "thread %d: %u chunks, %u stolen\n",
+            i, workers[i].chunks, workers[i].stolen);
+  }
+
+  fprintf(stderr, "%s %dx%d boards by fewest presses:\n",
+          enumerate ? "all" : "sampled", GRID_ROWS, GRID_COLS);
+  for(p = 0; p <= MAX_PRESSES; p++)
+    if(count[p])
+    {
+      fprintf(stderr, "%4d %12llu\n", p, count[p]);
+      longest = p;
+    }
+
+  /* split min_presses..longest into tiers of equal width */
+  if(min_presses < 0)
+    min_presses = longest / 3;
+  if(min_presses < 1)
+    min_presses = 1;
+  if(longest - min_presses + 1 < tiers)
+  {
+    fprintf(stderr, "%s: %d tiers do not fit in %d to %d presses\n",
+            argv[0], tiers, min_presses, longest);
+    return 1;
+  }
+  for(t = 0; t <= tiers; t++)
+    tier_lo[t] = min_presses + (longest - min_presses + 1) * t / tiers;
+
+  /* the per_tier smallest hashes of a tier are among the per_tier
+   * smallest of each of its press counts in each thread */
+  for(t = 0; t < tiers; t++)
+  {
+    int n = 0;
+    tier[t] = malloc((tier_lo[t + 1] - tier_lo[t]) * nthreads * per_tier *
+                     sizeof(cand_t));
+    for(p = tier_lo[t]; p < tier_lo[t + 1]; p++)
+      for(i = 0; i < nthreads; i++)
+      {
+        memcpy(&tier[t][n], workers[i].keep[p].c,
+               workers[i].keep[p].n * sizeof(cand_t));
+        n += workers[i].keep[p].n;
+      }
+
+    qsort(tier[t], n, sizeof(cand_t), cand_cmp);
+    tier_n[t] = 0;
+    for(i = 0; i < n && tier_n[t] < per_tier; i++)
+      if(tier_n[t] == 0 || cand_cmp(&tier[t][i], &tier[t][tier_n[t] - 1]))
+        tier[t][tier_n[t]++] = tier[t][i];
+    qsort(tier[t], tier_n[t], sizeof(cand_t), cand_board_cmp);
+
+    fprintf(stderr, "tier %d: %d to %d presses, %d boards\n",
+            t, tier_lo[t], tier_lo[t + 1] - 1, tier_n[t]);
+    if(tier_n[t] == 0)
+    {
+      fprintf(stderr, "%s: tier %d has no boards\n", argv[0], t);
+      return 1;
+    }
+  }
+
+  if(write_table(dir, tier, tier_n, tier_lo, tiers) < 0)
+  {
+    fprintf(stderr, "%s: cannot write the table in %s\n", argv[0], dir);
+    return 1;
+  }
+  return 0;
+}
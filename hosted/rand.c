@@ -0,0 +1,65 @@
+/** @file rand.c
+ *
+ *  @brief A Mersenne Twister standing in for the kernel's genrand
+ *
+ *  @author Heather Arthur (harthur)
+ *  @bug None known
+ **/
+
+#include <rand.h>
+
+#define MT_N 624
+#define MT_M 397
+#define MT_MATRIX_A 0x9908b0dfUL
+#define MT_UPPER 0x80000000UL
+#define MT_LOWER 0x7fffffffUL
+
+/* the generator state, mt_next is MT_N once it is used up and
+ * MT_N + 1 before the first seed */
+static unsigned long mt[MT_N];
+static int mt_next = MT_N + 1;
+
+/** @brief seeds the generator
+ *
+ *  @param seed the seed
+ *  @return Void
+ */
+void sgenrand(unsigned long seed)
+{
+  int i;
+
+  mt[0] = seed & 0xffffffffUL;
+  for(i = 1; i < MT_N; i++)
+    mt[i] = (69069 * mt[i - 1]) & 0xffffffffUL;
+  mt_next = MT_N;
+}
+
+/** @brief returns the next 32 bit random number
+ *
+ *  @return a random number, seeded with 4357 if sgenrand was not called
+ */
+unsigned long genrand(void)
+{
+  unsigned long y;
+  int i;
+
+  if(mt_next >= MT_N)
+  {
+    if(mt_next == MT_N + 1)
+      sgenrand(4357);
+
+    for(i = 0; i < MT_N; i++)
+    {
+      y = (mt[i] & MT_UPPER) | (mt[(i + 1) % MT_N] & MT_LOWER);
+      mt[i] = mt[(i + MT_M) % MT_N] ^ (y >> 1) ^ ((y & 1) ? MT_MATRIX_A : 0);
+    }
+    mt_next = 0;
+  }
+
+  y = mt[mt_next++];
+  y ^= y >> 11;
+  y ^= (y << 7) & 0x9d2c5680UL;
+  y ^= (y << 15) & 0xefc60000UL;
+  y ^= y >> 18;
+  return y & 0xffffffffUL;
+}
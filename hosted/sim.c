@@ -0,0 +1,527 @@
+/** @file sim.c
+ *
+ *  @brief The simulated machine of the hosted build
+ *
+ *  Stands in for port I/O, the interrupt flag, the handler install
+ *  and halting, see sim.h.
+ *
+ *  @author Heather Arthur (harthur)
+ *  @bug Only the registers the game uses are simulated, other ports
+ *       read as 0xFF and ignore writes
+ **/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/time.h>
+#include <410_reqs.h>
+#include <timer_defines.h>
+#include <interrupts.h>
+#include <keyhelp.h>
+#include <x86/pio.h>
+#include <x86/proc_reg.h>
+#include <console.h>
+#include <clock.h>
+#include <serial.h>
+#include <timer.h>
+#include <tickback_addr.h>
+#include <replay.h>
+#include "sim.h"
+
+/* the PIT mode bits of a channel, and the periodic modes */
+#define PIT_MODE(cmd) (((cmd) >> 1) & 0x7)
+#define PIT_RATE_GEN 2
+#define PIT_SQUARE 3
+
+/* 64 bit FNV-1a */
+#define FNV_OFFSET 0xcbf29ce484222325ULL
+#define FNV_PRIME 0x100000001b3ULL
+
+unsigned short sim_vram[SIM_VRAM_CELLS];
+unsigned long long sim_now = 0;
+unsigned long long sim_mmio_writes = 0;
+unsigned long long sim_pio_reads = 0;
+unsigned long long sim_pio_writes = 0;
+
+/* the interrupt flag */
+static int sim_if = 0;
+
+/* the CRTC register selected and the register file */
+static int crtc_idx = 0;
+static unsigned char crtc[256];
+
+/** @brief a PIT channel, counting from loaded */
+typedef struct {
+  int mode;                  /* mode bits of the last command */
+  unsigned int count;        /* the period, in PIT input cycles */
+  int lsb;                   /* the low byte, -1 until written */
+  int armed;                 /* whether a period is running */
+  unsigned long long fire;   /* when channel 0 ends its period */
+  struct timeval loaded;     /* when channel 2 was loaded */
+} pit_chan_t;
+
+static pit_chan_t pit0, pit2;
+/* the gate control port */
+static unsigned char pit_gate = 0;
+
+/* the scancode latched in the keyboard data port */
+static unsigned char kbd_data = 0;
+
+/* the injected scancodes and when each arrives */
+static unsigned char input[SIM_INPUT_MAX];
+static unsigned long long input_at[SIM_INPUT_MAX];
+static int input_head = 0;
+static int input_tail = 0;
+
+/* the serial line control register */
+static unsigned char serial_lcr = 0;
+
+/* run when sim_idle() has nothing left to deliver */
+static void (*sim_drained)(void) = NULL;
+
+/* the log being replayed, NULL when the scancode queue is used */
+static const unsigned char *rp_log = NULL;
+static unsigned int rp_len = 0;
+static unsigned int rp_pos = 0;
+/* the plays of the log left, counting the current one */
+static int rp_loops = 0;
+/* the tick count of the last tick record */
+static unsigned int rp_ticks = 0;
+
+unsigned long long sim_keys = 0;
+unsigned long long sim_frames = 0;
+unsigned long long sim_hash = FNV_OFFSET;
+int sim_hash_frames = 0;
+FILE *sim_hash_out = NULL;
+
+/** @brief loads a byte of a PIT channel's count
+ *
+ *  The count is low byte then high byte, a full count starts the
+ *  channel
+ *
+ *  @param ch the channel
+ *  @param val the byte written
+ *  @return Void
+ */
+static void pit_load(pit_chan_t *ch, unsigned char val)
+{
+  if(ch->lsb < 0)
+  {
+    ch->lsb = val;
+    return;
+  }
+
+  ch->count = (val << 8) | ch->lsb;
+  if(ch->count == 0)
+    ch->count = 0x10000;
+  ch->lsb = -1;
+  ch->armed = 1;
+  ch->fire = sim_now + ch->count;
+  gettimeofday(&ch->loaded, NULL);
+}
+
+/** @brief returns whether channel 2 has counted down, in real time
+ *
+ *  @return non-zero once the channel 2 period has passed
+ */
+static int pit2_out()
+{
+  struct timeval now;
+  unsigned long long us;
+
+  if(!pit2.armed)
+    return 0;
+
+  gettimeofday(&now, NULL);
+  us = (now.tv_sec - pit2.loaded.tv_sec) * 1000000ULL +
+       now.tv_usec - pit2.loaded.tv_usec;
+  return us * TIMER_RATE >= pit2.count * 1000000ULL;
+}
+
+/** @brief reads a byte from a simulated port
+ *
+ *  @param port the port to read
+ *  @return the value of the port
+ */
+unsigned char inb(unsigned short port)
+{
+  sim_pio_reads++;
+  switch(port)
+  {
+  case KEYBOARD_PORT:
+    return kbd_data;
+  case CRTC_DATA_REG:
+    return crtc[crtc_idx];
+  case PIT_GATE_IO_PORT:
+    return pit_gate | (pit2_out() ? PIT_GATE_OUT2 : 0);
+  case COM1_BASE + SERIAL_LSR:
+    return SERIAL_LSR_THRE;
+  }
+  return 0xFF;
+}
+
+/** @brief writes a byte to a simulated port
+ *
+ *  @param port the port to write
+ *  @param val the value written
+ *  @return Void
+ */
+void outb(unsigned short port, unsigned char val)
+{
+  sim_pio_writes++;
+  switch(port)
+  {
+  case CRTC_IDX_REG:
+    crtc_idx = val;
+    break;
+  case CRTC_DATA_REG:
+    crtc[crtc_idx] = val;
+    break;
+  case TIMER_MODE_IO_PORT:
+  {
+    pit_chan_t *ch = (val >> 6) == 2 ? &pit2 : &pit0;
+    ch->mode = PIT_MODE(val);
+    ch->lsb = -1;
+    ch->armed = 0;
+    break;
+  }
+  case TIMER_PERIOD_IO_PORT:
+    pit_load(&pit0, val);
+    break;
+  case PIT_CH2_IO_PORT:
+    pit_load(&pit2, val);
+    break;
+  case PIT_GATE_IO_PORT:
+    pit_gate = val & ~PIT_GATE_OUT2;
+    break;
+  case COM1_BASE + SERIAL_LCR:
+    serial_lcr = val;
+    break;
+  case COM1_BASE + SERIAL_DATA:
+    if(!(serial_lcr & SERIAL_LCR_DLAB))
+      fputc(val, stderr);
+    break;
+  }
+}
+
+/** @brief sets the interrupt flag */
+void enable_interrupts(void)
+{
+  sim_if = 1;
+}
+
+/** @brief clears the interrupt flag */
+void disable_interrupts(void)
+{
+  sim_if = 0;
+}
+
+/** @brief installs the timer and keyboard handlers
+ *
+ *  sim_idle() calls the handlers directly, so only the tickback and
+ *  the timer period are set up
+ *
+ *  @param tickback the function the timer handler calls each interrupt
+ *  @return 0
+ */
+int handler_install(void (*tickback)(unsigned int numTicks))
+{
+  tickback_addr = tickback;
+  timer_set_hz(TICK_HZ);
+  return 0;
+}
+
+/** @brief queues a scancode for the keyboard
+ *
+ *  @param code the scancode
+ *  @param gap_ms how long after the previous queued scancode it arrives
+ *  @return 0 on success, -1 if the queue is full
+ */
+int sim_scancode(unsigned char code, unsigned int gap_ms)
+{
+  unsigned long long last;
+
+  if(input_tail == SIM_INPUT_MAX)
+    return -1;
+
+  last = input_tail > input_head ? input_at[input_tail - 1] : sim_now;
+  input[input_tail] = code;
+  input_at[input_tail++] = last + (unsigned long long)gap_ms * SIM_CYCLES_PER_MS;
+  return 0;
+}
+
+/** @brief queues the scancodes that type a string
+ *
+ *  Each character is pressed and released, with shift held around it
+ *  if needed
+ *
+ *  @param keys the characters to type
+ *  @param gap_ms the time between key presses
+ *  @return 0 on success, -1 if a character has no key or the queue is full
+ */
+int sim_type(const char *keys, unsigned int gap_ms)
+{
+  unsigned char codes[4];
+  int i, n;
+
+  for(; *keys; keys++)
+  {
+    n = keyhelp_encode(*keys, codes);
+    if(n == 0)
+      return -1;
+    for(i = 0; i < n; i++)
+      if(sim_scancode(codes[i], i == 0 ? gap_ms : 0) < 0)
+        return -1;
+  }
+  return 0;
+}
+
+/** @brief sets the function run when there is nothing left to deliver
+ *
+ *  @param drained the function, must not return; NULL to exit
+ *  @return Void
+ */
+void sim_on_drained(void (*drained)(void))
+{
+  sim_drained = drained;
+}
+
+/** @brief runs the drained callback, then exits
+ *
+ *  @return Does not return
+ */
+static void drain()
+{
+  if(sim_drained)
+    sim_drained();
+  exit(0);
+}
+
+/** @brief hashes the cells on screen into the frame hashes
+ *
+ *  @return Void
+ */
+static void hash_frame()
+{
+  int start = (crtc[CRTC_START_MSB_IDX] << 8) | crtc[CRTC_START_LSB_IDX];
+  unsigned long long h = FNV_OFFSET;
+  int i;
+
+  for(i = 0; i < CONSOLE_WIDTH * CONSOLE_HEIGHT; i++)
+  {
+    unsigned short cell = sim_vram[(start + i) % SIM_VRAM_CELLS];
+    h = (h ^ (cell & 0xFF)) * FNV_PRIME;
+    h = (h ^ (cell >> 8)) * FNV_PRIME;
+  }
+
+  if(sim_hash_out)
+    fprintf(sim_hash_out, "%llu %016llx\n", sim_frames, h);
+  sim_hash = (sim_hash ^ h) * FNV_PRIME;
+}
+
+/** @brief reads a LEB128 number of the log being replayed
+ *
+ *  @param pos the position of the number, moved past it
+ *  @param n where the number is written
+ *  @return 0 on success, -1 if the log ends first
+ */
+static int replay_num(unsigned int *pos, unsigned int *n)
+{
+  int shift = 0;
+
+  *n = 0;
+  while(*pos < rp_len && shift < 7 * REPLAY_NUM_MAX)
+  {
+    unsigned char b = rp_log[(*pos)++];
+    *n |= (b & 0x7F) << shift;
+    shift += 7;
+    if(!(b & 0x80))
+      return 0;
+  }
+  return -1;
+}
+
+/** @brief finds the seed recorded for the grid being made
+ *
+ *  The grid is made while the key that asked for it is handled, but
+ *  its seed may be recorded after ticks that came in between, so the
+ *  log is searched ahead for the next seed
+ *
+ *  @param seed where the seed is written
+ *  @return 0 if a seed was found, -1 otherwise
+ */
+static int replay_find_seed(unsigned int *seed)
+{
+  unsigned int pos = rp_pos, n;
+
+  while(pos < rp_len)
+    switch(rp_log[pos++])
+    {
+    case REC_KEY:
+      pos++;
+      break;
+    case REC_TICK:
+      if(replay_num(&pos, &n) < 0)
+        return -1;
+      break;
+    case REC_SEED:
+      return replay_num(&pos, seed);
+    default:
+      return -1;
+    }
+  return -1;
+}
+
+/** @brief delivers the next record of the log being replayed
+ *
+ *  Scancodes go through the keyboard handler, tick counts straight
+ *  to the tickback as the timer handler would pass them. Seeds were
+ *  already used by replay_find_seed() and are skipped. At the end
+ *  of the log it starts over until every loop is done, the tick
+ *  counts carry on from the last one.
+ *
+ *  @return Void
+ */
+static void replay_next()
+{
+  unsigned int n;
+
+  while(1)
+  {
+    if(rp_pos == rp_len)
+    {
+      if(--rp_loops <= 0)
+        drain();
+      rp_pos = 0;
+    }
+
+    switch(rp_log[rp_pos++])
+    {
+    case REC_KEY:
+      if(rp_pos == rp_len)
+        break;
+      kbd_data = rp_log[rp_pos++];
+      sim_keys++;
+      key_handler();
+      return;
+    case REC_TICK:
+      if(replay_num(&rp_pos, &n) < 0)
+        break;
+      rp_ticks += n;
+      ticks = rp_ticks;
+      if(tickback_addr)
+        tickback_addr(rp_ticks);
+      return;
+    case REC_SEED:
+      if(replay_num(&rp_pos, &n) < 0)
+        break;
+      continue;
+    }
+
+    fprintf(stderr, "replay: bad record at %u\n", rp_pos);
+    drain();
+  }
+}
+
+/** @brief replays a recorded log instead of the scancode queue
+ *
+ *  Each halt delivers the next record with no simulated time passing
+ *  and no timer interrupts, so the log plays back as fast as the game
+ *  can take it
+ *
+ *  @param log the records of the log, after its header
+ *  @param len the length of the records
+ *  @param loops how many times to play the log
+ *  @return Void
+ */
+void sim_replay(const unsigned char *log, unsigned int len, int loops)
+{
+  rp_log = log;
+  rp_len = len;
+  rp_pos = 0;
+  rp_loops = loops;
+  replay_seed_source = replay_find_seed;
+}
+
+/** @brief halts until the next interrupt has been handled
+ *
+ *  Enables interrupts, moves the simulated time to the next timer
+ *  period or scancode, whichever is first, and runs its handler.
+ *  The kernel installs its handlers on trap gates, so on hardware an
+ *  interrupt can nest in a handler, here every handler runs to the
+ *  end before the next interrupt is delivered. Once every queued
+ *  scancode has been delivered the drained callback is run instead.
+ *  When replaying, the next record of the log is delivered.
+ *
+ *  @return Void
+ */
+void sim_idle()
+{
+  /* the game only halts once it has drawn everything it was sent */
+  sim_if = 1;
+  if(sim_hash_frames)
+    hash_frame();
+  sim_frames++;
+  if(!rp_log && input_head == input_tail)
+    drain();
+
+  if(rp_log)
+    replay_next();
+  else if(!pit0.armed || input_at[input_head] <= pit0.fire)
+  {
+    if(input_at[input_head] > sim_now)
+      sim_now = input_at[input_head];
+
+    /* scancodes due together interrupt back to back, before the game
+     * runs again */
+    do
+    {
+      kbd_data = input[input_head++];
+      sim_keys++;
+      key_handler();
+    }
+    while(input_head < input_tail && input_at[input_head] <= sim_now);
+  }
+  else
+  {
+    sim_now = pit0.fire;
+    if(pit0.mode == PIT_RATE_GEN || pit0.mode == PIT_SQUARE)
+      pit0.fire += pit0.count;
+    else
+      pit0.armed = 0;
+    timer_handler();
+  }
+}
+
+/** @brief reads a CRTC register
+ *
+ *  @param idx the register index
+ *  @return the register value
+ */
+int sim_crtc(int idx)
+{
+  return crtc[idx & 0xFF];
+}
+
+/** @brief prints the characters on screen, as the CRTC shows them
+ *
+ *  @param out the file to print to
+ *  @return Void
+ */
+void sim_screen(FILE *out)
+{
+  int start = (crtc[CRTC_START_MSB_IDX] << 8) | crtc[CRTC_START_LSB_IDX];
+  int row, col, end;
+
+  for(row = 0; row < CONSOLE_HEIGHT; row++)
+  {
+    unsigned short *line = &sim_vram[(start + row * CONSOLE_WIDTH) % SIM_VRAM_CELLS];
+    for(end = CONSOLE_WIDTH; end > 0 && (line[end - 1] & 0xFF) <= ' '; end--)
+      ;
+    for(col = 0; col < end; col++)
+    {
+      int ch = line[col] & 0xFF;
+      fputc(ch >= ' ' && ch < 0x7F ? ch : ' ', out);
+    }
+    fputc('\n', out);
+  }
+}
@@ -0,0 +1,78 @@
+/** @file sim.h
+ *
+ *  @brief contains the simulated machine of the hosted build
+ *
+ *  The hosted build runs the game as an ordinary Linux program. Port
+ *  I/O, video memory and interrupts are handled here instead of by
+ *  hardware: video memory is an array, the CRTC and PIT are register
+ *  files, and the keyboard delivers a queue of scancodes injected with
+ *  sim_scancode() or sim_type().
+ *
+ *  Interrupts are only delivered when the game halts. sim_idle()
+ *  moves the simulated time straight to the next timer period or
+ *  scancode and runs its handler, so a run takes no real time and
+ *  the same input always draws the same frames. Scancodes due at the
+ *  same time, such as those typed with no gap, are all delivered in
+ *  one halt, as a burst of typing would be. When no input is left
+ *  the drained callback is run, which by default exits.
+ *
+ *  A recorded log (see replay.h) can be played instead of the queue,
+ *  with sim_replay(). Each halt then delivers the next record
+ *  straight away.
+ *
+ *  The PIT channel 2 one shot used to calibrate the clock counts in
+ *  real time, so clock_ns() measures the host.
+ *
+ *  @author Heather Arthur (harthur)
+ */
+
+#ifndef __SIM_H
+#define __SIM_H
+
+#include <stdio.h>
+#include <timer_defines.h>
+#include <video_defines.h>
+
+/* the cells of video memory */
+#define SIM_VRAM_CELLS 0x4000
+
+/* the most scancodes that can be queued */
+#define SIM_INPUT_MAX 4096
+
+/* PIT input cycles per millisecond, rounded */
+#define SIM_CYCLES_PER_MS ((TIMER_RATE + 500) / 1000)
+
+/* video memory, a character and color per cell */
+extern unsigned short sim_vram[SIM_VRAM_CELLS];
+
+/* the simulated time, in PIT input cycles since startup */
+extern unsigned long long sim_now;
+
+/* the number of stores to video memory and of port reads and writes */
+extern unsigned long long sim_mmio_writes;
+extern unsigned long long sim_pio_reads;
+extern unsigned long long sim_pio_writes;
+
+/* the scancodes delivered, and the frames drawn: the game halts once
+ * it has drawn everything it was sent, so each halt ends a frame */
+extern unsigned long long sim_keys;
+extern unsigned long long sim_frames;
+/* a hash of every frame hashed so far */
+extern unsigned long long sim_hash;
+/* whether frames are hashed, and where each frame's hash is printed */
+extern int sim_hash_frames;
+extern FILE *sim_hash_out;
+
+int sim_scancode(unsigned char code, unsigned int gap_ms);
+int sim_type(const char *keys, unsigned int gap_ms);
+void sim_replay(const unsigned char *log, unsigned int len, int loops);
+void sim_idle();
+void sim_on_drained(void (*drained)(void));
+int sim_crtc(int idx);
+void sim_screen(FILE *out);
+
+/* the interrupt handlers the simulated machine runs */
+void timer_handler();
+void key_handler();
+
+#endif
@@ -0,0 +1,176 @@
+/** @file board.h
+ *
+ *  @brief contains the bitboard representation of the game grid
+ *
+ *  The grid is held in BOARD_WORDS words, one bit per square, with
+ *  square (row, col) at bit row * GRID_COLS + col. A set bit is a light
+ *  that is on. Pressing a square is one XOR with its toggle mask and
+ *  the game is won when the board is zero.
+ *
+ *  The size of the grid is fixed at compile time by GRID_ROWS and
+ *  GRID_COLS (3 through 9 each, 5x5 by default). Every operation on
+ *  a board is expanded once per word by BOARD_MAP, so each size gets
+ *  straight-line code with no loop over the words.
+ *
+ *  @author Heather Arthur (harthur)
+ */
+
+#ifndef __BOARD_H
+#define __BOARD_H
+
+/* The number of rows of squares in the grid */
+#ifndef GRID_ROWS
+#define GRID_ROWS 5
+#endif
+/* The number of columns of squares in the grid */
+#ifndef GRID_COLS
+#define GRID_COLS 5
+#endif
+
+#if GRID_ROWS < 3 || GRID_ROWS > 9 || GRID_COLS < 3 || GRID_COLS > 9
+#error "the grid must be between 3x3 and 9x9"
+#endif
+
+/* The number of squares in the grid */
+#define GRID_SQUARES (GRID_ROWS * GRID_COLS)
+/* The number of squares on the shorter side of the grid */
+#define GRID_MIN_SIDE (GRID_ROWS < GRID_COLS ? GRID_ROWS : GRID_COLS)
+
+/* The number of 32 bit words in a board */
+#define BOARD_WORDS ((GRID_SQUARES + 31) / 32)
+
+/* expands op(i) once for every word i of a board */
+#if BOARD_WORDS == 1
+#define BOARD_MAP(op) op(0)
+#elif BOARD_WORDS == 2
+#define BOARD_MAP(op) op(0) op(1)
+#else
+#define BOARD_MAP(op) op(0) op(1) op(2)
+#endif
+
+/* the bits of the last word that hold squares */
+#define BOARD_LAST_BITS (~0u >> (32 * BOARD_WORDS - GRID_SQUARES))
+
+/* the bit index of the square at (row, col) */
+#define SQUARE_BIT(row, col) ((row) * GRID_COLS + (col))
+/* the row and column of the square with bit index sq */
+#define SQUARE_ROW(sq) ((sq) / GRID_COLS)
+#define SQUARE_COL(sq) ((sq) % GRID_COLS)
+
+/** @brief a game grid, one bit per square */
+typedef struct {
+  unsigned int w[BOARD_WORDS];
+} board_t;
+
+/* toggle_masks[i] holds square i and its orthogonal neighbours */
+extern board_t toggle_masks[GRID_SQUARES];
+
+void board_init();
+int board_key(int sq);
+int board_square(int ch);
+
+/** @brief returns the board with no lights on */
+static inline board_t board_zero()
+{
+  board_t r;
+#define ZERO_WORD(i) r.w[i] = 0;
+  BOARD_MAP(ZERO_WORD)
+#undef ZERO_WORD
+  return r;
+}
+
+/** @brief returns the board with every light on */
+static inline board_t board_full()
+{
+  board_t r;
+#define FULL_WORD(i) r.w[i] = (i == BOARD_WORDS - 1) ? BOARD_LAST_BITS : ~0u;
+  BOARD_MAP(FULL_WORD)
+#undef FULL_WORD
+  return r;
+}
+
+/** @brief returns the board with only square sq on */
+static inline board_t board_bit(int sq)
+{
+  board_t r = board_zero();
+  r.w[sq >> 5] = 1u << (sq & 31);
+  return r;
+}
+
+/** @brief returns the squares on in exactly one of a and b */
+static inline board_t board_xor(board_t a, board_t b)
+{
+#define XOR_WORD(i) a.w[i] ^= b.w[i];
+  BOARD_MAP(XOR_WORD)
+#undef XOR_WORD
+  return a;
+}
+
+/** @brief returns the squares on in both a and b */
+static inline board_t board_and(board_t a, board_t b)
+{
+#define AND_WORD(i) a.w[i] &= b.w[i];
+  BOARD_MAP(AND_WORD)
+#undef AND_WORD
+  return a;
+}
+
+/** @brief returns non-zero if no square of b is on */
+static inline int board_empty(board_t b)
+{
+  unsigned int any = 0;
+#define OR_WORD(i) any |= b.w[i];
+  BOARD_MAP(OR_WORD)
+#undef OR_WORD
+  return !any;
+}
+
+/** @brief returns 1 if square sq of b is on, 0 otherwise */
+static inline int board_test(board_t b, int sq)
+{
+  return (b.w[sq >> 5] >> (sq & 31)) & 1;
+}
+
+/** @brief returns the byte k of b, bits 8k through 8k + 7 */
+static inline unsigned int board_byte(board_t b, int k)
+{
+  return (b.w[k >> 2] >> ((k & 3) * 8)) & 0xFF;
+}
+
+/** @brief returns the lowest square of b that is on, -1 if none */
+static inline int board_first(board_t b)
+{
+#define FIRST_WORD(i) if(b.w[i]) return i * 32 + __builtin_ctz(b.w[i]);
+  BOARD_MAP(FIRST_WORD)
+#undef FIRST_WORD
+  return -1;
+}
+
+/** @brief counts the set bits of a word */
+static inline int word_count(unsigned int w)
+{
+  w = w - ((w >> 1) & 0x55555555);
+  w = (w & 0x33333333) + ((w >> 2) & 0x33333333);
+  w = (w + (w >> 4)) & 0x0F0F0F0F;
+  return (w * 0x01010101) >> 24;
+}
+
+/** @brief counts the lit squares (or presses) in a board */
+static inline int board_count(board_t b)
+{
+  int count = 0;
+#define COUNT_WORD(i) count += word_count(b.w[i]);
+  BOARD_MAP(COUNT_WORD)
+#undef COUNT_WORD
+  return count;
+}
+
+/** @brief presses square sq on the board
+ *
+ *  @param board the board to press
+ *  @param sq the bit index of the square pressed
+ *  @return the board after the press
+ */
+#define BOARD_PRESS(board, sq) board_xor(board, toggle_masks[sq])
+
+#endif
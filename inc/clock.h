@@ -0,0 +1,51 @@
+/** @file clock.h
+ *
+ *  @brief contains the high resolution clock
+ *
+ *  The clock counts processor cycles with rdtsc. clock_init() measures
+ *  the cycle rate against the PIT once at boot, after that clock_ns()
+ *  converts cycles to nanoseconds with one multiply and shift. The
+ *  time stamp counter is assumed to run at a constant rate.
+ *
+ *  @author Heather Arthur (harthur)
+ */
+
+#ifndef __CLOCK_H
+#define __CLOCK_H
+
+/* the PIT channel 2 data port, gate control port and mode command */
+#define PIT_CH2_IO_PORT 0x42
+#define PIT_GATE_IO_PORT 0x61
+#define PIT_CH2_ONE_SHOT 0xB0
+
+/* bits of the gate control port */
+#define PIT_GATE_CH2 0x01
+#define PIT_GATE_SPEAKER 0x02
+#define PIT_GATE_OUT2 0x20
+
+/* the calibration period, in milliseconds */
+#define CALIBRATE_MS 10
+
+/* nanoseconds are cycles * clock_mult >> CLOCK_SHIFT */
+#define CLOCK_SHIFT 22
+
+/* the processor cycles per millisecond */
+extern unsigned int tsc_khz;
+
+/** @brief reads the processor time stamp counter
+ *
+ *  @return the number of cycles since the processor was reset
+ */
+static inline unsigned long long rdtsc()
+{
+  unsigned int lo, hi;
+  __asm__ __volatile__("rdtsc" : "=a" (lo), "=d" (hi));
+  return ((unsigned long long)hi << 32) | lo;
+}
+
+void clock_init();
+unsigned long long clock_ns();
+unsigned long long cycles_to_ns(unsigned long long cycles);
+unsigned int cycles_to_us(unsigned long long cycles);
+
+#endif
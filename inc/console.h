@@ -14,6 +14,16 @@
 #include <video_defines.h>
 #include <x86/pio.h>
 
+/* CRTC registers holding the cell shown at the top left of the screen */
+#define CRTC_START_MSB_IDX 12
+#define CRTC_START_LSB_IDX 13
+
+/* a character and its color as stored in video memory */
+#define CELL(ch, color) ((unsigned short)((((color) & 0xFF) << 8) | ((ch) & 0xFF)))
+
+/* the number of consoles console_save() can hold at once */
+#define CONSOLE_SNAPSHOTS 2
+
 /** @brief Prints character ch at the current location
  *         of the cursor.
  *
@@ -69,7 +79,8 @@ void backspace(int row, int col);
  *  continues on the new line.  If '\n', '\r', and '\b' are
  *  encountered within the string, they are handled
  *  as per putbyte. If len is not a positive integer or s
- *  is null, the function has no effect.
+ *  is null, the function has no effect. Runs of other characters
+ *  are written a line at a time with a single cursor update.
  *
  *  @param s The string to be printed.
  *  @param len The length of the string s.
@@ -101,7 +112,8 @@ void get_term_color(int* color);
  *    obtained from the row and col arguments.
  *
  *  Takes the value of row and col, whatever they are, and
- *  sets the cursor to this.
+ *  sets the cursor to this. The CRTC is updated by the next
+ *  sync_cursor().
  *
  *  @param row The new row for the cursor (or hidden value of row).
  *  @param col The new column for the cursor.
@@ -110,6 +122,17 @@ void get_term_color(int* color);
  */
 int set_real_cursor(int row, int col);
 
+/** @brief Writes the cursor position to the CRTC if it has changed.
+ *
+ *  The cursor functions only update a copy of the cursor kept in
+ *  memory, so moving the cursor costs no port I/O. The CRTC is only
+ *  written here, which putbytes() and console_flush() call once
+ *  per batch.
+ *
+ *  @return Void.
+ */
+void sync_cursor();
+
 /** @brief Writes the current position (non-logical)
  *         of the cursor into the arguments row and col.
  *  @param row The address to which the current cursor
@@ -183,6 +206,117 @@ void clear_console();
  */
 void draw_char(int row, int col, int ch, int color);
 
+/* The unchecked primitives below are for callers that already know
+ * their arguments are on the console and a valid color: nothing is
+ * checked, and a bad argument draws outside the console. */
+
+/** @brief Prints character ch with the specified color at (row, col)
+ *         without checking the arguments.
+ *
+ *  @param row The row in which to display the character.
+ *  @param col The column in which to display the character.
+ *  @param ch The character to display.
+ *  @param color The color to use to display the character.
+ *  @return Void.
+ */
+void draw_char_fast(int row, int col, int ch, int color);
+
+/** @brief Fills n cells of a row, from (row, col) rightwards.
+ *
+ *  Whole pairs of cells are written with one store each.
+ *
+ *  @param row The row to fill.
+ *  @param col The first column to fill.
+ *  @param n The number of cells, at most CONSOLE_WIDTH - col.
+ *  @param ch The character to fill with.
+ *  @param color The color to fill with.
+ *  @return Void.
+ */
+void fill_hspan(int row, int col, int n, int ch, int color);
+
+/** @brief Fills n cells of a column, from (row, col) downwards.
+ *
+ *  @param row The first row to fill.
+ *  @param col The column to fill.
+ *  @param n The number of cells, at most CONSOLE_HEIGHT - row.
+ *  @param ch The character to fill with.
+ *  @param color The color to fill with.
+ *  @return Void.
+ */
+void fill_vspan(int row, int col, int n, int ch, int color);
+
+/** @brief Fills a rectangle of cells with its top left at (row, col).
+ *
+ *  @param row The top row of the rectangle.
+ *  @param col The left column of the rectangle.
+ *  @param rows The height of the rectangle.
+ *  @param cols The width of the rectangle.
+ *  @param ch The character to fill with.
+ *  @param color The color to fill with.
+ *  @return Void.
+ */
+void fill_rect(int row, int col, int rows, int cols, int ch, int color);
+
+/** @brief Copies a run of prebuilt cells to position (row, col).
+ *
+ *  For painters that work out once where they draw and with what.
+ *  Nothing is checked: the run must lie on one row of the console
+ *  and every cell must be a valid CELL().
+ *
+ *  @param row The row of the first cell.
+ *  @param col The column of the first cell.
+ *  @param cells The cells to copy.
+ *  @param n The number of cells, at most CONSOLE_WIDTH - col.
+ *  @return Void.
+ */
+void draw_cells(int row, int col, const unsigned short *cells, int n);
+
+/** @brief Copies everything drawn since the last flush to video memory.
+ *
+ *  All drawing goes to an off-screen copy of the console. This writes
+ *  the dirty span of each row to video memory, one pair of cells per
+ *  store, skipping pairs that already hold the same cells. Each
+ *  changed cell is written once however many times it was drawn.
+ *
+ *  @return Void.
+ */
+void console_flush();
+
+/** @brief Saves the console in a free snapshot slot.
+ *
+ *  Copies every cell as drawn, the cursor and the terminal color
+ *  into one of CONSOLE_SNAPSHOTS preallocated slots, so a screen
+ *  drawn over the console can later be taken off again with
+ *  console_restore().
+ *
+ *  @return the slot saved in, or -1 if every slot is in use.
+ */
+int console_save();
+
+/** @brief Puts back a console saved by console_save() and frees its slot.
+ *
+ *  The cells are copied back in one go and, like any drawing, reach
+ *  video memory at the next console_flush(), which only writes the
+ *  cells that differ from what is shown.
+ *
+ *  @param slot the slot returned by console_save().
+ *  @return 0 on success or integer error code less than 0 if
+ *          slot holds no console.
+ */
+int console_restore(int slot);
+
+/** @brief Turns hardware scrolling on or off.
+ *
+ *  With hardware scrolling on, scrolling the console moves the CRTC
+ *  start address down a line, so a flush only writes the new line
+ *  instead of the whole screen. Turning it off moves the screen back
+ *  to the start of video memory. It is on by default.
+ *
+ *  @param enable non-zero to scroll with the CRTC start address.
+ *  @return Void.
+ */
+void hw_scroll(int enable);
+
 /** @brief Returns the character displayed at position (row, col).
  *  @param row Row of the character.
  *  @param col Column of the character.
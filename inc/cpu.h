@@ -0,0 +1,28 @@
+/** @file cpu.h
+ *
+ *  @brief contains small processor control helpers
+ *
+ *  @author Heather Arthur (harthur)
+ */
+
+#ifndef __CPU_H
+#define __CPU_H
+
+/* stops the compiler moving memory accesses across this point, x86
+ * keeps stores in order and loads in order by itself */
+#define barrier() __asm__ __volatile__("" : : : "memory")
+
+/** @brief enables interrupts and halts until the next one arrives
+ *
+ *  sti only takes effect after the instruction that follows it, so an
+ *  interrupt arriving between the two still wakes the hlt. Callers
+ *  disable interrupts, check for work, then call this.
+ *
+ *  @return Void
+ */
+static inline void halt_for_interrupt()
+{
+  __asm__ __volatile__("sti; hlt" : : : "memory");
+}
+
+#endif
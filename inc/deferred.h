@@ -0,0 +1,39 @@
+/** @file deferred.h
+ *
+ *  @brief contains prototypes of the deferred work queue
+ *
+ *  Interrupt handlers must stay short and must not draw, since the
+ *  main loop may be in the middle of drawing. Instead they post a work
+ *  bit here, and the main loop runs the handler for each posted bit
+ *  once, however many times it was posted.
+ *
+ *  @author Heather Arthur (harthur)
+ */
+
+#ifndef __DEFERRED_H
+#define __DEFERRED_H
+
+/* the kinds of deferred work, one bit each */
+#define DEFER_TIME 0x1   /* the visible game time has changed */
+
+/* the number of kinds of deferred work */
+#define DEFER_KINDS 1
+
+/* the work posted and not yet run */
+extern volatile unsigned int deferred_pending;
+
+/** @brief posts deferred work, safe to call from interrupt context
+ *
+ *  @param work the DEFER_ bits to post
+ *  @return Void
+ */
+static inline void defer_post(unsigned int work)
+{
+  __asm__ __volatile__("lock; orl %1, %0"
+		       : "+m" (deferred_pending) : "r" (work) : "memory");
+}
+
+void defer_handler(unsigned int work, void (*handler)(void));
+void run_deferred();
+
+#endif
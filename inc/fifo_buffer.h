@@ -3,21 +3,37 @@
  *  @brief contains prototypes of keyboard queue manipulators and
  *		the buffer global variables	
  *
+ *  The queue has a single producer (the keyboard handler) and a single
+ *  consumer (readchar), so it needs no lock: head is only written by
+ *  the producer and tail only by the consumer.
+ *
  *  @author Heather Arthur (harthur)
  */
 
 #ifndef __FIFO_BUFFER_H
 #define __FIFO_BUFFER_H
 
+#include <cpu.h>
+
+/* the number of scancodes the queue holds, must be a power of two */
 #define BUFF_SIZE 1024
+#define BUFF_MASK (BUFF_SIZE - 1)
+
+#if BUFF_SIZE & BUFF_MASK
+#error "BUFF_SIZE must be a power of two"
+#endif
 
-/* character buffer */
-extern int head;
-extern int tail;
-extern char buffer[BUFF_SIZE];
+/* character buffer, head and tail count up forever and are masked
+ * into buffer, the queue holds head - tail scancodes */
+extern volatile unsigned int head;
+extern volatile unsigned int tail;
+extern unsigned char buffer[BUFF_SIZE];
 
+/* the number of scancodes dropped because the queue was full */
+extern volatile unsigned int dropped;
 
 void enqueue_char(int scancode);
 int dequeue_char();
+int dequeue_n(unsigned char *codes, int n);
 
 #endif
@@ -9,16 +9,22 @@
 #define __GAME_PLAY_H
 
 void game_run();
+void handle_key(int ch);
+int wait_key();
+void show_time();
 void handle_win();
 void handle_loss();
 void handle_ins();
+void handle_diag();
+void handle_trace();
 void handle_char(char ch);
+void handle_hint();
+void clear_hint();
 void handle_new();
 void new_game();
 void generate_grid();
 void initialize_grid();
 void toggle_char(char ch);
-void toggle_square(int row, int col);
 int is_win();
 
 #endif 
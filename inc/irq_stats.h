@@ -0,0 +1,55 @@
+/** @file irq_stats.h
+ *
+ *  @brief contains the interrupt latency instrumentation
+ *
+ *  Each instrumented handler records the cycles it ran for and how
+ *  regularly it arrived, as log2 histograms. Each interrupt's stats
+ *  are only written by its handler and read with a sequence count,
+ *  so no lock is needed. Build with NO_IRQ_STATS to compile the
+ *  instrumentation out of the handlers.
+ *
+ *  @author Heather Arthur (harthur)
+ */
+
+#ifndef __IRQ_STATS_H
+#define __IRQ_STATS_H
+
+#include <clock.h>
+
+#ifndef NO_IRQ_STATS
+#define IRQ_STATS
+#endif
+
+/* the instrumented interrupts */
+#define IRQ_TIMER 0
+#define IRQ_KEY 1
+#define IRQ_COUNT 2
+
+/* one bucket per power of two cycles */
+#define HIST_BUCKETS 32
+
+/** @brief the statistics of one interrupt */
+typedef struct {
+  unsigned int count;                  /* interrupts seen */
+  unsigned int max_duration;           /* longest handler run, in cycles */
+  unsigned int duration[HIST_BUCKETS]; /* handler runs by log2 cycles */
+  unsigned int jitter[HIST_BUCKETS];   /* change in gap by log2 cycles */
+  unsigned long long last;             /* cycle count at the last entry */
+  unsigned int last_gap;               /* cycles between the last two */
+} irq_stats_t;
+
+unsigned long long irq_enter(int irq);
+void irq_exit(int irq, unsigned long long start);
+void irq_stats_read(int irq, irq_stats_t *out);
+void irq_stats_reset();
+
+#ifdef IRQ_STATS
+/* records the entry to and exit from an interrupt handler */
+#define IRQ_ENTER(irq) unsigned long long irq_start = irq_enter(irq)
+#define IRQ_EXIT(irq) irq_exit(irq, irq_start)
+#else
+#define IRQ_ENTER(irq)
+#define IRQ_EXIT(irq)
+#endif
+
+#endif
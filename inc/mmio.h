@@ -0,0 +1,26 @@
+/** @file mmio.h
+ *
+ *  @brief contains accessors for memory-mapped device memory
+ *
+ *  Every store to video memory goes through these, so the compiler
+ *  never merges, reorders or drops them.
+ *
+ *  @author Heather Arthur (harthur)
+ */
+
+#ifndef __MMIO_H
+#define __MMIO_H
+
+/** @brief writes a 16 bit value to device memory */
+static inline void mmio_write16(volatile void *addr, unsigned short val)
+{
+  *(volatile unsigned short *)addr = val;
+}
+
+/** @brief writes a 32 bit value to device memory */
+static inline void mmio_write32(volatile void *addr, unsigned int val)
+{
+  *(volatile unsigned int *)addr = val;
+}
+
+#endif
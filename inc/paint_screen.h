@@ -8,6 +8,8 @@
 #ifndef __PAINT_SCREEN_H
 #define __PAINT_SCREEN_H
 
+#include <board.h>
+
 /* The color combinations*/
 #define TOOL_COLOR (FGND_BLACK | BGND_LGRAY)
 #define DEFAULT_COLOR (FGND_WHITE | BGND_BLACK)
@@ -15,33 +17,53 @@
 #define TITLE_COLOR (FGND_YLLW | BGND_BLACK)
 #define ON_COLOR (FGND_BLACK | BGND_LGRAY)
 #define OFF_COLOR (FGND_WHITE | BGND_BLACK)
+#define HINT_ON_COLOR (FGND_BLACK | BGND_GREEN)
+#define HINT_OFF_COLOR (FGND_WHITE | BGND_GREEN)
+
+/* or-ed into the on value of paint_square to highlight a hint */
+#define SQUARE_HINT 2
 
 /* The top left corner of the grid - row value */
 #define GRID_ROW 2
 /* The top left corner of the grid - column value*/
 #define GRID_COL (CONSOLE_WIDTH / 2)
-/* The width and height of a square in the grid */
+/* The width of a square in the grid */
 #define SQUARE_WIDTH 3
+/* The height of a square in the grid, grids taller than 5 squares
+ * only get one row per square to fit on the console */
+#if GRID_ROWS <= 5
+#define SQUARE_HEIGHT 3
+#else
+#define SQUARE_HEIGHT 1
+#endif
+/* The number of console rows and columns covered by the grid frame */
+#define GRID_HEIGHT (GRID_ROWS * (SQUARE_HEIGHT + 1) + 1)
+#define GRID_WIDTH (GRID_COLS * (SQUARE_WIDTH + 1) + 1)
 /* The row where the statistic start */
 #define STATS_ROW (CONSOLE_HEIGHT / 2 - 3)
 /* the column where the statistics start */
 #define STATS_COL (CONSOLE_WIDTH / 8)
+/* the most histogram rows on the interrupt statistics screen */
+#define DIAG_ROWS (CONSOLE_HEIGHT - 8)
+/* the number of events on the trace screen */
+#define TRACE_ROWS (CONSOLE_HEIGHT - 4)
 
 
-/* convert from (row, col) to character */
-#define TOCHAR(row,col) (97 + row*5 + col)
-#define TOROW(ch) ((ch - 97) / 5)
-#define TOCOL(ch) ((ch - 97) % 5)
-
+void paint_init();
 void title_screen();
-void game_screen(int grid[5][5], int moves, int wins, int losses);
+void game_screen(board_t board, int moves, int wins, int losses);
 void win_screen();
 void ins_screen();
+void diag_screen();
+void trace_screen();
 void paint_toolbar(char *message);
-void paint_grid(int grid[5][5]);
+void paint_grid(board_t board);
+void paint_squares(board_t board, board_t mask);
 void paint_stats(int moves, int wins, int losses);
 void paint_title();
+void paint_keys();
 void update_time(unsigned int time);
+void paint_time();
 void paint_square(int row, int col, int on);
 void paint_row(int row);
 void paint_frame();
@@ -0,0 +1,28 @@
+/** @file puzzle_table.h
+ *
+ *  @brief contains the table of starting boards
+ *
+ *  Generated by hosted/puzzlegen, do not edit. The boards of tier t
+ *  are puzzle_table[puzzle_start[t]] up to puzzle_start[t + 1], each
+ *  needs at least puzzle_presses[t] presses. Tiers are in order of
+ *  difficulty.
+ *
+ *  @author Heather Arthur (harthur)
+ */
+
+#ifndef __PUZZLE_TABLE_H
+#define __PUZZLE_TABLE_H
+
+/* the grid the table was generated for */
+#define PUZZLE_ROWS 5
+#define PUZZLE_COLS 5
+/* the 32 bit words of each board */
+#define PUZZLE_WORDS 1
+/* the number of difficulty tiers */
+#define PUZZLE_TIERS 4
+
+extern const unsigned int puzzle_table[][PUZZLE_WORDS];
+extern const unsigned short puzzle_start[PUZZLE_TIERS + 1];
+extern const unsigned char puzzle_presses[PUZZLE_TIERS];
+
+#endif
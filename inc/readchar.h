@@ -0,0 +1,29 @@
+/** @file readchar.h
+ *
+ *  @brief contains the decoded key event queue of the keyboard driver
+ *
+ *  Scancodes queued by the keyboard handler are decoded in batches
+ *  by the main loop, and only key presses are kept, so callers never
+ *  see break codes or modifier keys.
+ *
+ *  @author Heather Arthur (harthur)
+ */
+
+#ifndef __READCHAR_H
+#define __READCHAR_H
+
+/* the number of decoded events queued, must be a power of two */
+#define EVENT_QUEUE_SIZE 64
+#define EVENT_QUEUE_MASK (EVENT_QUEUE_SIZE - 1)
+
+/** @brief a key press decoded from the keyboard */
+typedef struct {
+  unsigned long long time;   /* clock_ns() when it was decoded */
+  int ch;                    /* the character, as readchar returns it */
+} key_event_t;
+
+int decode_scancodes();
+int next_events(key_event_t *events, int max);
+int wait_for_event(key_event_t *events, int max);
+
+#endif
@@ -0,0 +1,70 @@
+/** @file replay.h
+ *
+ *  @brief contains the input recording and its log format
+ *
+ *  Every scancode the keyboard handler queues and every tick count
+ *  the timer handler passes to the tickback is appended to a log in
+ *  memory, in the order they happened, and so is the seed of every
+ *  new grid. Feeding the same log back through the handlers replays
+ *  a game exactly: a timer interrupt can land between a key and the
+ *  grid it starts, so the player forces the recorded seeds instead
+ *  of taking them from the replayed ticks (see replay_seed_source).
+ *  Recording stops when the log is full,
+ *  a replay has to start from boot. Build with NO_RECORD to compile
+ *  the recording out.
+ *
+ *  A log is a REPLAY_HDR_SIZE byte header followed by records:
+ *    REC_KEY, scancode
+ *    REC_TICK, ticks since the previous REC_TICK as LEB128
+ *    REC_SEED, the seed of a new grid as LEB128
+ *  so a key costs two bytes and a tick usually two.
+ *
+ *  @author Heather Arthur (harthur)
+ */
+
+#ifndef __REPLAY_H
+#define __REPLAY_H
+
+/* the bytes of recorded input kept */
+#define REPLAY_LOG_SIZE 0x10000
+
+/* the header: "LOR", version, grid rows and columns, tick rate as a
+ * 16 bit and log length as a 32 bit little endian number */
+#define REPLAY_MAGIC "LOR"
+#define REPLAY_VERSION 2
+#define REPLAY_HDR_SIZE 12
+
+/* record kinds */
+#define REC_KEY 1
+#define REC_TICK 2
+#define REC_SEED 3
+
+/* a LEB128 number is at most this long */
+#define REPLAY_NUM_MAX 5
+
+extern unsigned char replay_log[REPLAY_LOG_SIZE];
+extern unsigned int replay_len;
+/* the records dropped because the log was full */
+extern unsigned int replay_dropped;
+/* set by a player of logs to a function that finds the recorded seed
+ * of the next grid, returning 0 if it found one */
+extern int (*replay_seed_source)(unsigned int *seed);
+
+void replay_key(unsigned char code);
+void replay_tick(unsigned int numTicks);
+unsigned int replay_seed(unsigned int seed);
+void replay_header(unsigned char *hdr, unsigned int len);
+int replay_check_header(const unsigned char *hdr, unsigned int *len);
+void replay_dump_serial();
+
+#ifndef NO_RECORD
+#define REPLAY_KEY(code) replay_key(code)
+#define REPLAY_TICK(numTicks) replay_tick(numTicks)
+#define REPLAY_SEED(seed) replay_seed(seed)
+#else
+#define REPLAY_KEY(code)
+#define REPLAY_TICK(numTicks)
+#define REPLAY_SEED(seed) (seed)
+#endif
+
+#endif
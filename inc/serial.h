@@ -0,0 +1,35 @@
+/** @file serial.h
+ *
+ *  @brief contains prototypes of the polled serial port driver
+ *
+ *  @author Heather Arthur (harthur)
+ */
+
+#ifndef __SERIAL_H
+#define __SERIAL_H
+
+/* the I/O base of the first serial port */
+#define COM1_BASE 0x3F8
+
+/* registers, as offsets from the base */
+#define SERIAL_DATA 0      /* transmit buffer, divisor low with DLAB */
+#define SERIAL_IER 1       /* interrupt enable, divisor high with DLAB */
+#define SERIAL_FCR 2       /* FIFO control */
+#define SERIAL_LCR 3       /* line control */
+#define SERIAL_MCR 4       /* modem control */
+#define SERIAL_LSR 5       /* line status */
+
+#define SERIAL_LCR_DLAB 0x80   /* divisor latch access */
+#define SERIAL_LCR_8N1 0x03    /* 8 data bits, no parity, 1 stop bit */
+#define SERIAL_FCR_ON 0xC7     /* enable and clear the FIFOs */
+#define SERIAL_MCR_ON 0x03     /* DTR and RTS */
+#define SERIAL_LSR_THRE 0x20   /* transmit buffer empty */
+
+/* divisor of the 115200 baud base clock */
+#define SERIAL_DIVISOR 1
+
+void serial_init();
+void serial_putc(char ch);
+void serial_write(const char *s, int len);
+
+#endif
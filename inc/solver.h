@@ -0,0 +1,28 @@
+/** @file solver.h
+ *
+ *  @brief contains prototypes of the lights out solver
+ *
+ *  A board is solved as the linear system A x = b over GF(2), where A
+ *  holds the toggle masks, b is the board and x the set of squares
+ *  to press. The elimination is done once by solver_init(), after
+ *  that a solve is a fixed number of table lookups.
+ *
+ *  @author Heather Arthur (harthur)
+ */
+
+#ifndef __SOLVER_H
+#define __SOLVER_H
+
+#include <board.h>
+
+/* the number of bytes of a board looked up per solve */
+#define SOLVE_CHUNKS ((GRID_SQUARES + 7) / 8)
+/* an upper bound on the dimension of the null space of A */
+#define NULL_MAX GRID_MIN_SIDE
+
+void solver_init();
+int solve(board_t board, board_t *presses);
+board_t solver_minimize(board_t presses);
+int solvable(board_t board);
+
+#endif
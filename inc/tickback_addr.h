@@ -8,6 +8,7 @@
 #ifndef __TICKBACK_ADDR_H
 #define __TICKBACK_ADDR_H
 
-void (*tickback_addr)(unsigned int);
+/* defined in timer_handler.c, NULL until a tickback is installed */
+extern void (*tickback_addr)(unsigned int);
 
 #endif
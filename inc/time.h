@@ -2,19 +2,21 @@
  *
  * @brief contains the global variables representing time for game
  *
+ * They are defined in tick.c
+ *
  * @author Heather Arthur (harthur)
  */
 
 #ifndef __TIME_H
 #define __TIME_H
 
-/* time elapsed during this game in milliseconds */
-unsigned int game_time;
+/* time elapsed during this game in timer ticks (see tick_hz) */
+extern unsigned int game_time;
 
-/* time elapsed since start-up in milliseconds */
-unsigned int total_time;
+/* time elapsed since start-up in timer ticks (see tick_hz) */
+extern unsigned int total_time;
 
 /* whether tick should increment time */
-int can_tick;
+extern int can_tick;
 
 #endif
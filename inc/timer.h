@@ -0,0 +1,37 @@
+/** @file timer.h
+ *
+ *  @brief contains the timer tick rate and tickless mode controls
+ *
+ *  Time is counted in ticks of 1 / tick_hz seconds. In periodic mode
+ *  the PIT interrupts once per tick. In tickless mode it is programmed
+ *  one shot at a time, only as far as the next deadline asked for with
+ *  timer_deadline(), and each interrupt adds every tick it covered.
+ *
+ *  @author Heather Arthur (harthur)
+ */
+
+#ifndef __TIMER_H
+#define __TIMER_H
+
+/* the default number of ticks per second */
+#define TICK_HZ 100
+
+/* the largest count the PIT can be programmed with */
+#define PIT_MAX_COUNT 0xFFFF
+/* channel 0, low then high byte, interrupt on terminal count */
+#define PIT_ONE_SHOT 0x30
+
+/* no deadline, tickless mode waits as long as the PIT allows */
+#define NO_DEADLINE 0xFFFFFFFF
+
+/* the current number of ticks per second */
+extern unsigned int tick_hz;
+/* the number of ticks since startup */
+extern volatile unsigned int ticks;
+
+int timer_set_hz(unsigned int hz);
+void timer_tickless(int enable);
+int timer_is_tickless();
+void timer_deadline(unsigned int tick);
+
+#endif
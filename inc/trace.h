@@ -0,0 +1,78 @@
+/** @file trace.h
+ *
+ *  @brief contains the event trace rings
+ *
+ *  Each kind of event has its own ring of the most recent records,
+ *  so one kind firing often cannot push the others out, and each
+ *  ring is only written from one context (interrupt or main loop)
+ *  so it needs no lock. Recording an event is a time stamp, three
+ *  stores and an index update. Build with NO_TRACE to compile the
+ *  trace points out.
+ *
+ *  @author Heather Arthur (harthur)
+ */
+
+#ifndef __TRACE_H
+#define __TRACE_H
+
+#include <clock.h>
+#include <cpu.h>
+
+/* the traced events */
+#define TR_TIMER 0   /* timer interrupt: ticks, ticks covered */
+#define TR_KEY 1     /* keyboard interrupt: scancode, queue length */
+#define TR_CHAR 2    /* square key handled: key, moves */
+#define TR_PAINT 3   /* square painted: square, on */
+#define TR_FLUSH 4   /* console flushed: pairs written, rows */
+#define TR_TYPES 5
+
+/* the records kept per event, must be a power of two */
+#define TRACE_RING_SIZE 64
+#define TRACE_RING_MASK (TRACE_RING_SIZE - 1)
+
+/** @brief one traced event */
+typedef struct {
+  unsigned long long time;   /* rdtsc when it happened */
+  unsigned int id;           /* the TR_ event */
+  unsigned int arg0;
+  unsigned int arg1;
+} trace_rec_t;
+
+/** @brief the recent records of one event */
+typedef struct {
+  unsigned int next;         /* records ever written, masked into rec */
+  trace_rec_t rec[TRACE_RING_SIZE];
+} trace_ring_t;
+
+extern trace_ring_t trace_rings[TR_TYPES];
+
+/** @brief records an event in its ring
+ *
+ *  @param id the TR_ event
+ *  @param arg0, arg1 event specific values
+ *  @return Void
+ */
+static inline void trace(int id, unsigned int arg0, unsigned int arg1)
+{
+  trace_ring_t *ring = &trace_rings[id];
+  trace_rec_t *rec = &ring->rec[ring->next & TRACE_RING_MASK];
+
+  rec->time = rdtsc();
+  rec->id = id;
+  rec->arg0 = arg0;
+  rec->arg1 = arg1;
+  barrier();
+  ring->next++;
+}
+
+#ifndef NO_TRACE
+#define TRACE(id, arg0, arg1) trace(id, arg0, arg1)
+#else
+#define TRACE(id, arg0, arg1)
+#endif
+
+const char *trace_name(int id);
+int trace_collect(trace_rec_t *out, int max);
+void trace_dump_serial();
+
+#endif
@@ -0,0 +1,120 @@
+/** @file irq_stats.c
+ * 
+ *  @brief Histograms of interrupt handler duration and arrival jitter
+ *  
+ *  @author Heather Arthur (harthur) 
+ *  @bug None known
+ **/
+
+#include <irq_stats.h>
+#include <cpu.h>
+#include <string.h>
+#include <x86/proc_reg.h>
+
+/* the statistics of each interrupt */
+static irq_stats_t stats[IRQ_COUNT];
+/* odd while the handler is updating stats[irq] */
+static volatile unsigned int seq[IRQ_COUNT];
+
+/** @brief returns the histogram bucket of a number of cycles
+ *
+ *  @param cycles the number of cycles
+ *  @return floor(log2(cycles)), 0 for 0 cycles
+ */
+static int bucket(unsigned int cycles)
+{
+  return 31 - __builtin_clz(cycles | 1);
+}
+
+/** @brief clamps a 64 bit cycle count to 32 bits
+ *
+ *  @param cycles the number of cycles
+ *  @return cycles, or the largest 32 bit value if it is larger
+ */
+static unsigned int clamp32(unsigned long long cycles)
+{
+  return cycles > 0xFFFFFFFF ? 0xFFFFFFFF : (unsigned int)cycles;
+}
+
+/** @brief records the entry to an interrupt handler
+ *
+ *  Records how much the gap since the last interrupt differs from
+ *  the gap before it
+ *
+ *  @param irq the IRQ_ number of the interrupt
+ *  @return the cycle count at entry, to pass to irq_exit
+ */
+unsigned long long irq_enter(int irq)
+{
+  unsigned long long now = rdtsc();
+  irq_stats_t *s = &stats[irq];
+
+  seq[irq]++;
+  barrier();
+
+  if(s->count)
+  {
+    unsigned int gap = clamp32(now - s->last);
+    if(s->count > 1)
+    {
+      unsigned int diff = gap > s->last_gap ? gap - s->last_gap :
+					       s->last_gap - gap;
+      s->jitter[bucket(diff)]++;
+    }
+    s->last_gap = gap;
+  }
+  s->last = now;
+  s->count++;
+  return now;
+}
+
+/** @brief records the exit from an interrupt handler
+ *
+ *  @param irq the IRQ_ number of the interrupt
+ *  @param start the cycle count irq_enter returned
+ *  @return Void
+ */
+void irq_exit(int irq, unsigned long long start)
+{
+  irq_stats_t *s = &stats[irq];
+  unsigned int cycles = clamp32(rdtsc() - start);
+
+  s->duration[bucket(cycles)]++;
+  if(cycles > s->max_duration)
+    s->max_duration = cycles;
+
+  barrier();
+  seq[irq]++;
+}
+
+/** @brief takes a consistent copy of an interrupt's statistics
+ *
+ *  Copies again if the handler ran during the copy
+ *
+ *  @param irq the IRQ_ number of the interrupt
+ *  @param out where the copy is written
+ *  @return Void
+ */
+void irq_stats_read(int irq, irq_stats_t *out)
+{
+  unsigned int before;
+  do
+  {
+    before = seq[irq];
+    barrier();
+    memcpy(out, &stats[irq], sizeof(*out));
+    barrier();
+  }
+  while((before & 1) || before != seq[irq]);
+}
+
+/** @brief clears the statistics of every interrupt
+ *
+ *  @return Void
+ */
+void irq_stats_reset()
+{
+  disable_interrupts();
+  memset(stats, 0, sizeof(stats));
+  enable_interrupts();
+}
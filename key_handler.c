@@ -10,6 +10,9 @@
 #include <x86/pio.h>
 #include <interrupts.h>
 #include <fifo_buffer.h>
+#include <irq_stats.h>
+#include <trace.h>
+#include <replay.h>
 
 /** @brief The keyboard press handler
  *  
@@ -21,11 +24,17 @@
  */
 void key_handler()
 {
+  IRQ_ENTER(IRQ_KEY);
+
   /* queue scan code */
   int scancode = inb(KEYBOARD_PORT);
+  REPLAY_KEY(scancode);
   enqueue_char(scancode);
+  TRACE(TR_KEY, scancode, head - tail);
 
-  /* allow more key interrupts */
+  /* allow more key interrupts, once the stats are done so a nested
+   * key interrupt cannot tear them */
+  IRQ_EXIT(IRQ_KEY);
   outb(INT_CTL_REG, INT_CTL_DONE); 
 }
 
@@ -7,9 +7,133 @@
  **/
 
 #include <stdio.h>
+#include <string.h>
 #include <console.h>
 #include <video_defines.h>
 #include <paint_screen.h>
+#include <timer.h>
+#include <irq_stats.h>
+#include <fifo_buffer.h>
+#include <trace.h>
+
+/* the ways a square is painted, on | SQUARE_HINT */
+#define SQUARE_STYLES 4
+
+/* the widgets of the game screen */
+#define W_TOOLBAR 0x01
+#define W_TITLE 0x02
+#define W_FRAME 0x04
+#define W_STATS 0x08
+#define W_TIMER 0x10
+#define W_ALL 0x1F
+
+/* the width the statistics are padded to, so a shorter value
+ * covers a longer one */
+#define STATS_WIDTH 12
+
+/** @brief the game screen as it is on the console
+ *
+ *  Every widget keeps what it last painted. The squares and the hint
+ *  are kept by paint_square(), so a widget is only repainted when its
+ *  contents change or another screen has painted over it.
+ */
+typedef struct {
+  int shown;               /* whether the game screen is on the console */
+  unsigned int invalid;    /* the W_ widgets to repaint */
+  board_t board;           /* the lights shown on the grid */
+  int hint;                /* the square shown highlighted, -1 if none */
+  int moves;               /* the statistics shown */
+  int wins;
+  int losses;
+  unsigned int seconds;    /* the time shown */
+} scene_t;
+
+static scene_t scene = { 0, W_ALL, { { 0 } }, -1, 0, 0, 0, 0 };
+
+/* the cells of each square in each style, built by paint_init() */
+static unsigned short sprites[GRID_SQUARES][SQUARE_STYLES]
+                             [SQUARE_HEIGHT][SQUARE_WIDTH];
+/* the console row and column of the top left cell of each square */
+static unsigned char square_row[GRID_SQUARES];
+static unsigned char square_col[GRID_SQUARES];
+
+static void paint_sprite(int sq, int on);
+
+/* the console slot holding the game screen under an overlay, -1 if
+ * none, and the scene it shows */
+static int overlay = -1;
+static scene_t under;
+
+/** @brief clears the console for a screen drawn over the game screen
+ *
+ *  If the game screen is up it is saved first, so game_screen() can
+ *  put it back with one copy instead of repainting it.
+ *
+ *  @return Void
+ */
+static void open_overlay()
+{
+  if(scene.shown && overlay < 0 && (overlay = console_save()) >= 0)
+    under = scene;
+  init_screen();
+}
+
+/** @brief takes the overlay off, putting back the game screen under it
+ *
+ *  The time may have moved on while the overlay was up, so the timer
+ *  is repainted if it did.
+ *
+ *  @return Void
+ */
+static void close_overlay()
+{
+  unsigned int seconds = scene.seconds;
+
+  if(overlay < 0)
+    return;
+  console_restore(overlay);
+  overlay = -1;
+
+  scene = under;
+  if(seconds != scene.seconds)
+  {
+    scene.seconds = seconds;
+    scene.invalid |= W_TIMER;
+  }
+}
+
+/** @brief builds the square sprites
+ *
+ *  Every square is painted in one of four styles, on or off with or
+ *  without a hint, as blank cells with its key in the middle. All of
+ *  them are built here along with where each square goes, so
+ *  painting a square only copies its rows. Must be called before
+ *  any square is painted.
+ *
+ *  @param Void
+ *  @return Void
+ */
+void paint_init()
+{
+  static const int colors[SQUARE_STYLES] =
+    { OFF_COLOR, ON_COLOR, HINT_OFF_COLOR, HINT_ON_COLOR };
+  int sq, style, i, j;
+
+  for(sq = 0; sq < GRID_SQUARES; sq++)
+  {
+    square_row[sq] = GRID_ROW + 1 + SQUARE_ROW(sq)*(SQUARE_HEIGHT + 1);
+    square_col[sq] = GRID_COL + 1 + SQUARE_COL(sq)*(SQUARE_WIDTH + 1);
+
+    for(style = 0; style < SQUARE_STYLES; style++)
+    {
+      for(i = 0; i < SQUARE_HEIGHT; i++)
+	for(j = 0; j < SQUARE_WIDTH; j++)
+	  sprites[sq][style][i][j] = CELL(' ', colors[style]);
+      sprites[sq][style][SQUARE_HEIGHT / 2][SQUARE_WIDTH / 2] =
+	CELL(board_key(sq), colors[style]);
+    }
+  }
+}
 
 /** @brief paints the title screen  
  *
@@ -32,30 +156,65 @@ void title_screen()
 
 /** @brief paints the current game screen  
  *
- *  Paints the game screen (grid, toolbar, and statistics)
+ *  Paints the game screen (grid, toolbar, and statistics). An overlay
+ *  screen drawn over it is taken off first. If the game screen is
+ *  then on the console only the squares and statistics that changed
+ *  are repainted, and the hint is cleared. Otherwise the console is
+ *  cleared and every widget repainted from what it holds, the time
+ *  shown included.
  *
- *  @param Void
+ *  @param board the current board
+ *  @param moves the number of moves in this game
+ *  @param wins the number of wins so far
+ *  @param losses the number of losses so far
  *  @return Void
  */
-void game_screen(int grid[5][5], int moves, int wins, int losses)
+void game_screen(board_t board, int moves, int wins, int losses)
 {
-  init_screen();
-  paint_toolbar("Press <a-y> to toggle square <I> Instructions <N> New game <Q> Quit");
-  paint_grid(grid);
+  board_t stale;
+
+  close_overlay();
+  if(!scene.shown)
+  {
+    init_screen();
+    scene.shown = 1;
+    scene.invalid = W_ALL;
+    stale = board_full();
+  }
+  else
+  {
+    stale = board_xor(scene.board, board);
+    if(scene.hint >= 0 && !board_test(stale, scene.hint))
+      stale = board_xor(stale, board_bit(scene.hint));
+  }
+
+  if(scene.invalid & W_TOOLBAR)
+  {
+    paint_toolbar("Press ");
+    paint_keys();
+    printf(" to toggle square <H> Hint <I> Instructions <N> New game <Q> Quit");
+  }
+  if(scene.invalid & W_TITLE)
+    paint_title();
+  if(scene.invalid & W_FRAME)
+    paint_frame();
+  paint_squares(board, stale);
   paint_stats(moves, wins, losses);
-  paint_title();
+  if(scene.invalid & W_TIMER)
+    paint_time();
+  scene.invalid = 0;
 }
 
 /** @brief paints the win screen  
  *
- *  Writes a win message to the screen
+ *  Writes a win message to the screen, over the game screen
  *
  *  @param Void
  *  @return Void
  */
 void win_screen()
 {
-  init_screen();
+  open_overlay();
   set_cursor(CONSOLE_HEIGHT/2, CONSOLE_WIDTH/2 - 8);
   printf("CONGRATULATIONS!");
   set_cursor(CONSOLE_HEIGHT/2 + 1, CONSOLE_WIDTH/2 - 3);
@@ -66,27 +225,110 @@ void win_screen()
 
 /** @brief paints the instruction screen  
  *
- *  Writes the game instructions to the screen
+ *  Writes the game instructions to the screen, over the game screen
  *
  *  @param Void
  *  @return Void
  */
 void ins_screen()
 {
-  init_screen();
+  open_overlay();
   printf("Use the following keys at any point in the game:\n\n");
-  printf("<a-y> to toggle the light at this grid location\n");
+  paint_keys();
+  printf(" to toggle the light at this grid location\n");
+  printf("<H> to highlight the next light to toggle\n");
   printf("<N> to end the current game (and lose) and begin a new one\n");
   printf("<I> to access these instructions\n");
+  printf("<S> to show interrupt statistics\n");
+  printf("<T> to show the most recent events\n");
   printf("<Q> to quit the game\n\n");
   printf("The goal of this game is to turn out all the lights on the grid.\n");
-  printf("Pressing a character a-y will flip the light at that respective \n");
+  printf("Pressing the key on a square will flip the light at that respective\n");
   printf("grid location and also flip the lights at the locations above,\n");
   printf("below, and to the left and right of this character location.\n");
 
   paint_toolbar("Press any key to resume game");
 }
 
+/** @brief paints the interrupt statistics screen
+ *
+ *  Shows how many cycles the timer and keyboard handlers ran for
+ *  and how much the gap between interrupts varied, one row per
+ *  power of two cycles that has any counts. In tickless mode the
+ *  timer is meant to come at uneven gaps, so its jitter is not shown.
+ *
+ *  @param Void
+ *  @return Void
+ */
+void diag_screen()
+{
+  irq_stats_t timer, key;
+  int b, lo = HIST_BUCKETS, hi = -1;
+  int tickless = timer_is_tickless();
+
+  irq_stats_read(IRQ_TIMER, &timer);
+  irq_stats_read(IRQ_KEY, &key);
+  if(tickless)
+    memset(timer.jitter, 0, sizeof(timer.jitter));
+
+  for(b = 0; b < HIST_BUCKETS; b++)
+    if(timer.duration[b] || timer.jitter[b] || key.duration[b] ||
+       key.jitter[b])
+    {
+      if(b < lo)
+	lo = b;
+      hi = b;
+    }
+
+  /* keep the table above the toolbar */
+  if(hi - lo + 1 > DIAG_ROWS)
+    hi = lo + DIAG_ROWS - 1;
+
+  open_overlay();
+  printf("Interrupt statistics (%u cycles per ms)\n\n", tsc_khz);
+  printf("timer:    %u interrupts, longest %u cycles%s\n",
+	 timer.count, timer.max_duration,
+	 tickless ? ", tickless so no jitter" : "");
+  printf("keyboard: %u interrupts, longest %u cycles, %u dropped\n\n",
+	 key.count, key.max_duration, dropped);
+
+  printf("cycles    timer run  timer jitter    key run    key jitter\n");
+  for(b = lo; b <= hi; b++)
+  {
+    printf("2^%-2d %12u ", b, timer.duration[b]);
+    if(tickless)
+      printf("%12s", "-");
+    else
+      printf("%12u", timer.jitter[b]);
+    printf(" %12u %12u\n", key.duration[b], key.jitter[b]);
+  }
+
+  paint_toolbar("<C> Clear the statistics, any other key to resume");
+}
+
+/** @brief paints the event trace screen
+ *
+ *  Lists the most recent traced events, oldest first, with how many
+ *  microseconds each came before the last one
+ *
+ *  @param Void
+ *  @return Void
+ */
+void trace_screen()
+{
+  trace_rec_t recs[TRACE_ROWS];
+  int i, n = trace_collect(recs, TRACE_ROWS);
+
+  open_overlay();
+  printf("   us ago  event        arg0       arg1\n\n");
+  for(i = 0; i < n; i++)
+    printf("%9u  %-6s %10u %10u\n",
+	   cycles_to_us(recs[n - 1].time - recs[i].time),
+	   trace_name(recs[i].id), recs[i].arg0, recs[i].arg1);
+
+  paint_toolbar("Serial dump: <D> the trace <R> the input recording, any other key to resume");
+}
+
 /** @brief paints the toolbar of the game screen  
  *
  *  Writes the toolbar to the bottom row of the screen
@@ -103,20 +345,36 @@ void paint_toolbar(char *message)
 
 /** @brief paints the current grid of the game screen  
  *
- *  Writes the game grid to the screen based on the values in 
- *  the grid
+ *  Writes the game grid to the screen based on the bits of 
+ *  the board
  *
- *  @param Void
+ *  @param board the current board
  *  @return Void
  */
-void paint_grid(int grid[5][5])
+void paint_grid(board_t board)
 {
   paint_frame();
+  paint_squares(board, board_full());
+}
 
-  int i,j;
-  for(i = 0; i < 5; i++)
-    for(j = 0; j < 5; j++)
-      paint_square(i,j,grid[i][j]);
+/** @brief repaints some squares of the grid
+ *
+ *  Paints every square whose bit is set in mask with its current
+ *  value in board, other squares are left alone
+ *
+ *  @param board the current board
+ *  @param mask the squares to repaint
+ *  @return Void
+ */
+void paint_squares(board_t board, board_t mask)
+{
+  int sq;
+  mask = board_and(mask, board_full());
+  while((sq = board_first(mask)) >= 0)
+  {
+    paint_sprite(sq, board_test(board, sq));
+    mask = board_xor(mask, board_bit(sq));
+  }
 }
 
 /** @brief paints the current statistics for the game  
@@ -131,13 +389,23 @@ void paint_grid(int grid[5][5])
  */
 void paint_stats(int moves, int wins, int losses)
 {
+  char record[STATS_WIDTH + 1];
+
+  if(!(scene.invalid & W_STATS) && moves == scene.moves &&
+     wins == scene.wins && losses == scene.losses)
+    return;
+  scene.moves = moves;
+  scene.wins = wins;
+  scene.losses = losses;
+
   set_term_color(DEFAULT_COLOR);
   set_cursor(STATS_ROW, 0);
-  printf("moves made:\n%d\n", moves);
+  printf("moves made:\n%-*d\n", STATS_WIDTH, moves);
   printf("time elapsed:\n\n" );
-  printf("wins:\n%d\n", wins);
-  printf("losses:\n%d\n", losses);
-  printf("record:\n%d/%d\n",wins, losses + wins);
+  printf("wins:\n%-*d\n", STATS_WIDTH, wins);
+  printf("losses:\n%-*d\n", STATS_WIDTH, losses);
+  snprintf(record, sizeof(record), "%d/%d", wins, losses + wins);
+  printf("record:\n%-*s\n", STATS_WIDTH, record);
 }
 
 /** @brief paints the title on game screen  
@@ -151,71 +419,116 @@ void paint_title()
   printf("LIGHTS OUT!");
 }
 
+/** @brief prints the range of keys that press squares
+ *
+ *  Grids of up to 26 squares are pressed with the letters, larger
+ *  grids use every key shown on the squares
+ *
+ *  @return Void
+ */
+void paint_keys()
+{
+#if GRID_SQUARES <= 26
+  printf("<a-%c>", board_key(GRID_SQUARES - 1));
+#else
+  printf("<key>");
+#endif
+}
+
 /** @brief paints new time to the screen
  *
- *  Writes new time value (in seconds) over the old one on the screen
+ *  Writes new time value (in seconds) over the old one on the screen.
+ *  While another screen is up the time is only kept, to be painted
+ *  when the game screen returns.
  *
- *  @param time the time elapsed since last call to update
+ *  @param time the time elapsed in this game, in ticks
  *  @return Void
  */
 void update_time(unsigned int time)
 {
-  unsigned int seconds = time / 100;
+  unsigned int seconds = time / tick_hz;
+  if(seconds == scene.seconds && !(scene.invalid & W_TIMER))
+    return;
+
+  scene.seconds = seconds;
+  if(scene.shown)
+    paint_time();
+  else
+    scene.invalid |= W_TIMER;
+}
+
+/** @brief paints the time held by the scene
+ *
+ *  @return Void
+ */
+void paint_time()
+{
   set_term_color(DEFAULT_COLOR);
   set_cursor(STATS_ROW + 3, 0);
-  printf("%u   ", seconds);
+  printf("%-*u", STATS_WIDTH, scene.seconds);
 }
 
 /** @brief paints a square to the grid of the game screen  
  *
- *  Writes the square to the (row, col) of the grid
+ *  Copies the rows of the square's sprite to the console, keeping
+ *  the scene in step with what is shown
+ *
+ *  @param sq the square to paint
+ *  @param on  boolean on/off value, with SQUARE_HINT set to highlight
+ *  @return Void
+ */
+static void paint_sprite(int sq, int on)
+{
+  int i;
+  int style = on & (SQUARE_HINT | 1);
+  TRACE(TR_PAINT, sq, on);
+
+  /* keep the scene in step with the console */
+  if(board_test(scene.board, sq) != (on & 1))
+    scene.board = board_xor(scene.board, board_bit(sq));
+  if(on & SQUARE_HINT)
+    scene.hint = sq;
+  else if(scene.hint == sq)
+    scene.hint = -1;
+
+  for(i = 0; i < SQUARE_HEIGHT; i++)
+    draw_cells(square_row[sq] + i, square_col[sq], sprites[sq][style][i],
+	       SQUARE_WIDTH);
+}
+
+/** @brief paints the square at (row, col) of the grid
+ *
+ *  The (row, col) wrapper around paint_sprite()
  *
  *  @param row the row of the square to paint
- *  @param col the col of the squeare to paint
- *  @param on  boolean on/off value
+ *  @param col the col of the square to paint
+ *  @param on  boolean on/off value, with SQUARE_HINT set to highlight
  *  @return Void
  */
 void paint_square(int row, int col, int on)
 {
-  int i,j;
-  int color;
-  if(on)
-    color = ON_COLOR;
-  else
-    color = OFF_COLOR;
-
-  /* color in the square*/
-  int start_row = GRID_ROW + 1 + row*(SQUARE_WIDTH + 1);
-  int start_col = GRID_COL + 1 + col*(SQUARE_WIDTH + 1);
-  for(i = 0; i < SQUARE_WIDTH; i++)
-    for(j = 0; j < SQUARE_WIDTH; j++)
-      draw_char(start_row + i, start_col + j, ' ', color);
-
-  /* add the character */
-  int char_row = start_row + SQUARE_WIDTH / 2;
-  int char_col = start_col + SQUARE_WIDTH / 2;
-  draw_char(char_row, char_col, TOCHAR(row, col), color);
+  paint_sprite(SQUARE_BIT(row, col), on);
 }
 
 /** @brief paints a row in the current background color
  *
- *   No action if row is not on the console
+ *   No action if row is not on the console. The cursor is left at
+ *   the start of the row.
  *
  *  @param row the row to paint
  *  @return Void
  */
 void paint_row(int row)
 {
-  if(row < 0 || row > CONSOLE_HEIGHT)
+  int color;
+
+  if(row < 0 || row >= CONSOLE_HEIGHT)
     return;
-  set_cursor(row, 0);
-  int i;
-  for(i = 0; i < (CONSOLE_WIDTH - 1); i++)
-    putbyte(' ');
 
-  /* paint last character of this row to avoid scrolling */
-  draw_char(row, CONSOLE_WIDTH - 1, ' ', TOOL_COLOR);
-  putbyte('\r');  
+  /* filled rather than printed, so the last cell does not scroll */
+  get_term_color(&color);
+  fill_hspan(row, 0, CONSOLE_WIDTH, ' ', color);
+  set_cursor(row, 0);
 }
 
 /** @brief paints the frame of the grid
@@ -226,27 +539,29 @@ void paint_row(int row)
 void paint_frame()
 {
   /* columns */
-  int i, j;
-  for(i = 0; i < 6; i++)
-    for(j = GRID_ROW; j < (GRID_ROW + SQUARE_WIDTH*5 + 6); j++)
-      draw_char(j ,GRID_COL + i*4,' ',BOUND_COLOR);
+  int i;
+  for(i = 0; i <= GRID_COLS; i++)
+    fill_vspan(GRID_ROW, GRID_COL + i*(SQUARE_WIDTH + 1), GRID_HEIGHT,
+	       ' ', BOUND_COLOR);
 
   /* rows */
-  int p, q;
-  for(p = 0; p <= 6; p++)
-    for(q = GRID_COL; q < (GRID_COL + SQUARE_WIDTH*5 + 6); q++)
-      draw_char(GRID_ROW + p*4, q, ' ', BOUND_COLOR);
+  for(i = 0; i <= GRID_ROWS; i++)
+    fill_hspan(GRID_ROW + i*(SQUARE_HEIGHT + 1), GRID_COL, GRID_WIDTH,
+	       ' ', BOUND_COLOR);
 }
 
 /** @brief sets console up for a new screen
  *
- *  Clears the console and changes colors to default
+ *  Clears the console and changes colors to default. The game screen
+ *  is painted over, so every widget is repainted when it returns.
  *
  *  @param Void
  *  @return Void
  */
 void init_screen()
 {
+  scene.shown = 0;
+  scene.invalid = W_ALL;
   set_term_color(DEFAULT_COLOR);
   clear_console();
 }
@@ -0,0 +1,278 @@
+/** @file puzzle_table.c
+ *
+ *  @brief The starting boards of a 5x5 grid, by difficulty
+ *
+ *  Generated by hosted/puzzlegen, do not edit.
+ *
+ *  @author Heather Arthur (harthur)
+ *  @bug None known
+ **/
+
+#include <puzzle_table.h>
+
+const unsigned char puzzle_presses[PUZZLE_TIERS] = { 5, 7, 10, 13 };
+
+const unsigned short puzzle_start[PUZZLE_TIERS + 1] = { 0, 256, 512, 768, 1024 };
+
+const unsigned int puzzle_table[][PUZZLE_WORDS] = {
+  /* tier 0, 5 or more presses */
+  { 0x00003e06 }, { 0x00020324 }, { 0x0002897d }, { 0x0002d0e2 },
+  { 0x00045ea6 }, { 0x000557ee }, { 0x000660b5 }, { 0x0006c900 },
+  { 0x00085531 }, { 0x00097417 }, { 0x000c7335 }, { 0x000f0198 },
+  { 0x0012cdc0 }, { 0x00137379 }, { 0x001866b8 }, { 0x001d215b },
+  { 0x001dccb8 }, { 0x00213ee9 }, { 0x002215ff }, { 0x0027472b },
+  { 0x002a0752 }, { 0x002bd885 }, { 0x002be033 }, { 0x002bfdbd },
+  { 0x002bfe9a }, { 0x002da296 }, { 0x002e5921 }, { 0x00308914 },
+  { 0x0032547f }, { 0x0032a034 }, { 0x00332972 }, { 0x0035cc97 },
+  { 0x0039eb90 }, { 0x003bc4c9 }, { 0x003e2783 }, { 0x0040290e },
+  { 0x004147d2 }, { 0x00415c73 }, { 0x00450c6d }, { 0x0045ac05 },
+  { 0x0045d126 }, { 0x004c54ad }, { 0x004c6051 }, { 0x004daa38 },
+  { 0x004e1957 }, { 0x004e586d }, { 0x004ee674 }, { 0x005002f7 },
+  { 0x0052a70b }, { 0x00532200 }, { 0x00548110 }, { 0x0055150a },
+  { 0x0056697c }, { 0x0056dea9 }, { 0x0059f492 }, { 0x005c785f },
+  { 0x005dcfd1 }, { 0x005efcd9 }, { 0x006030e4 }, { 0x0060b331 },
+  { 0x0064aae1 }, { 0x0064d2ca }, { 0x0065331c }, { 0x00654b53 },
+  { 0x00667a0e }, { 0x00688bc9 }, { 0x0068cdf8 }, { 0x006bba9e },
+  { 0x006e1dfd }, { 0x0071da95 }, { 0x007572cd }, { 0x0075921b },
+  { 0x0076766b }, { 0x00772c62 }, { 0x00774266 }, { 0x00783dfd },
+  { 0x0079b800 }, { 0x007d28ae }, { 0x007dad70 }, { 0x00802c47 },
+  { 0x0086c4f9 }, { 0x00887006 }, { 0x008cae0e }, { 0x008db0ce },
+  { 0x008e33b8 }, { 0x008ea1f8 }, { 0x008ea3a7 }, { 0x008f3e3c },
+  { 0x00921f67 }, { 0x0095965a }, { 0x00964ec8 }, { 0x009b43d7 },
+  { 0x009e2d46 }, { 0x00a0e0a4 }, { 0x00a18238 }, { 0x00a38d9f },
+  { 0x00a5c9a3 }, { 0x00adab43 }, { 0x00adbdc1 }, { 0x00aded2e },
+  { 0x00afbbea }, { 0x00b04383 }, { 0x00b0c1ea }, { 0x00b9b550 },
+  { 0x00ba59cf }, { 0x00bcb7a5 }, { 0x00bd35ef }, { 0x00c12726 },
+  { 0x00c22343 }, { 0x00c2af24 }, { 0x00c338e2 }, { 0x00c7369e },
+  { 0x00c85586 }, { 0x00c86159 }, { 0x00cabb88 }, { 0x00cd9996 },
+  { 0x00d13be4 }, { 0x00d21614 }, { 0x00d43b2d }, { 0x00d896b7 },
+  { 0x00db4d7d }, { 0x00e0d0c1 }, { 0x00e6b7ce }, { 0x00e6bebe },
+  { 0x00e95310 }, { 0x00ee1f0d }, { 0x00f15af7 }, { 0x00f3a48c },
+  { 0x00f9a83a }, { 0x00fbe792 }, { 0x00ff0972 }, { 0x00ff9e4f },
+  { 0x00ffae95 }, { 0x01048d8b }, { 0x0104af7b }, { 0x0104e4ce },
+  { 0x010a2b53 }, { 0x010a3060 }, { 0x010ca857 }, { 0x010cf40e },
+  { 0x010d6687 }, { 0x010e71f0 }, { 0x01104540 }, { 0x01195638 },
+  { 0x011cdd3d }, { 0x011d864b }, { 0x011df098 }, { 0x011f6bcf },
+  { 0x0125a086 }, { 0x01269f72 }, { 0x012b960b }, { 0x012c5a0e },
+  { 0x012d44ad }, { 0x012dd237 }, { 0x012edcc6 }, { 0x012f05a6 },
+  { 0x012f51c2 }, { 0x012f9842 }, { 0x012fbb44 }, { 0x012fbd3d },
+  { 0x01314c83 }, { 0x0132d9e2 }, { 0x01334ae2 }, { 0x0135bcd6 },
+  { 0x0135d661 }, { 0x013b0e4c }, { 0x013b67ff }, { 0x013c4e23 },
+  { 0x013ce3ec }, { 0x013f7090 }, { 0x01422c58 }, { 0x0143954a },
+  { 0x0143be67 }, { 0x01460980 }, { 0x014894ed }, { 0x014ac401 },
+  { 0x014b2bfd }, { 0x014b38e8 }, { 0x015513ea }, { 0x01578806 },
+  { 0x01580e20 }, { 0x015910e7 }, { 0x015baebd }, { 0x015ce525 },
+  { 0x01637d20 }, { 0x01648d6a }, { 0x016944b8 }, { 0x016db121 },
+  { 0x016fe28e }, { 0x0172ef90 }, { 0x0176511c }, { 0x017d25e5 },
+  { 0x01810957 }, { 0x0181a532 }, { 0x0181cc61 }, { 0x0183ca47 },
+  { 0x01876870 }, { 0x0187813c }, { 0x0188154f }, { 0x0188e4e1 },
+  { 0x01895589 }, { 0x018a4d46 }, { 0x018df2bc }, { 0x01927567 },
+  { 0x01938900 }, { 0x0196c3d1 }, { 0x01999752 }, { 0x019997ff },
+  { 0x0199ecf4 }, { 0x019dd2ae }, { 0x01a99f30 }, { 0x01aa1827 },
+  { 0x01aaa710 }, { 0x01b06f58 }, { 0x01b07de7 }, { 0x01b0db84 },
+  { 0x01b1bd17 }, { 0x01b26cae }, { 0x01b910cd }, { 0x01b9d984 },
+  { 0x01bb1aba }, { 0x01bf507a }, { 0x01c03bee }, { 0x01c1db47 },
+  { 0x01c3e13f }, { 0x01c41437 }, { 0x01c42d30 }, { 0x01c5339e },
+  { 0x01c55bbf }, { 0x01c6a9e7 }, { 0x01c91ae5 }, { 0x01cd6fc3 },
+  { 0x01cdedf1 }, { 0x01ce8004 }, { 0x01d3b550 }, { 0x01d4e310 },
+  { 0x01d573b3 }, { 0x01d736d9 }, { 0x01dc777c }, { 0x01de5ffc },
+  { 0x01de8d61 }, { 0x01df99c3 }, { 0x01e3be36 }, { 0x01e502a1 },
+  { 0x01e5565a }, { 0x01e70695 }, { 0x01e7b260 }, { 0x01ea8623 },
+  { 0x01ec92fa }, { 0x01eeff70 }, { 0x01f58d0a }, { 0x01f90343 },
+  { 0x01f99525 }, { 0x01fb2a40 }, { 0x01fc2f4c }, { 0x01fd1e96 },
+  /* tier 1, 7 or more presses */
+  { 0x00040acf }, { 0x00049b7a }, { 0x0004ddb0 }, { 0x0006702a },
+  { 0x0007cb55 }, { 0x000a35f6 }, { 0x000e30f4 }, { 0x0011085f },
+  { 0x0019dc91 }, { 0x001a47a2 }, { 0x0020a562 }, { 0x00214f6a },
+  { 0x002410fe }, { 0x00258386 }, { 0x0029ce4e }, { 0x002c41ae },
+  { 0x002c5a3d }, { 0x002d2f5b }, { 0x0037a51f }, { 0x0038a0cf },
+  { 0x003953eb }, { 0x003c35ce }, { 0x003efaab }, { 0x004003ce },
+  { 0x0041e204 }, { 0x004226e3 }, { 0x00429c9b }, { 0x004415cf },
+  { 0x004b32f9 }, { 0x004c3b55 }, { 0x004d5972 }, { 0x004f4818 },
+  { 0x00523b48 }, { 0x00550cb4 }, { 0x00560dd4 }, { 0x0059d267 },
+  { 0x005b32d1 }, { 0x005c9130 }, { 0x005d0e26 }, { 0x00617576 },
+  { 0x0064351d }, { 0x0068512e }, { 0x0069db97 }, { 0x006c8996 },
+  { 0x006ce5ae }, { 0x00739c64 }, { 0x00756231 }, { 0x00783345 },
+  { 0x0079fcbb }, { 0x007be21b }, { 0x007cf9c6 }, { 0x007d2eda },
+  { 0x007e820d }, { 0x007f2d8c }, { 0x007f43cf }, { 0x008299b1 },
+  { 0x0083ba5a }, { 0x0083c966 }, { 0x00842b34 }, { 0x008672cc },
+  { 0x0086ca6f }, { 0x0087ba5a }, { 0x0088e667 }, { 0x008a20bb },
+  { 0x008b7878 }, { 0x00906f95 }, { 0x009334bc }, { 0x0093c2f9 },
+  { 0x0093ec76 }, { 0x0094ee18 }, { 0x0097213d }, { 0x009db20f },
+  { 0x009de479 }, { 0x009e6588 }, { 0x00a2b6bf }, { 0x00a38c00 },
+  { 0x00a46481 }, { 0x00a4aea8 }, { 0x00a4e031 }, { 0x00a576cf },
+  { 0x00a9b7ee }, { 0x00a9f505 }, { 0x00aa1954 }, { 0x00ac5c99 },
+  { 0x00ac99fe }, { 0x00add30b }, { 0x00ae74cb }, { 0x00ae86f9 },
+  { 0x00b0f153 }, { 0x00b1f8ad }, { 0x00b22e52 }, { 0x00b495a0 },
+  { 0x00b63808 }, { 0x00b647fd }, { 0x00b77800 }, { 0x00b91abf },
+  { 0x00bc96ed }, { 0x00bceb89 }, { 0x00bdc434 }, { 0x00bddbc1 },
+  { 0x00be11de }, { 0x00be7173 }, { 0x00bf760d }, { 0x00c27911 },
+  { 0x00c5aa74 }, { 0x00c85b94 }, { 0x00c99756 }, { 0x00ca9e34 },
+  { 0x00cb0576 }, { 0x00d05524 }, { 0x00d27fd5 }, { 0x00d2d9aa },
+  { 0x00d2dbc0 }, { 0x00d306f3 }, { 0x00d309ac }, { 0x00d35bfc },
+  { 0x00d443ac }, { 0x00d4d2f3 }, { 0x00d710ca }, { 0x00d873f1 },
+  { 0x00d9eee3 }, { 0x00dbcec1 }, { 0x00dcd09d }, { 0x00e03ef4 },
+  { 0x00e16bd0 }, { 0x00e4635b }, { 0x00e5ff52 }, { 0x00ece91d },
+  { 0x00eddffe }, { 0x00ee6a48 }, { 0x00efb5d8 }, { 0x00f0bf11 },
+  { 0x00f12886 }, { 0x00f23539 }, { 0x00f693de }, { 0x00f73389 },
+  { 0x00fc3e98 }, { 0x00fd697c }, { 0x00fef14b }, { 0x01028d25 },
+  { 0x01058362 }, { 0x01086e9e }, { 0x010ee411 }, { 0x0110eb14 },
+  { 0x0113372e }, { 0x01150542 }, { 0x011ded23 }, { 0x011ed7aa },
+  { 0x012314a5 }, { 0x012503a0 }, { 0x012d67f7 }, { 0x012e6b37 },
+  { 0x012ee2e4 }, { 0x0132b1df }, { 0x01333058 }, { 0x013781c1 },
+  { 0x013f53bf }, { 0x0140b46f }, { 0x01428ce5 }, { 0x0143138c },
+  { 0x0144a401 }, { 0x0145f6fb }, { 0x0149ef0c }, { 0x014ab56f },
+  { 0x014bf7ad }, { 0x014c3a3d }, { 0x014d383e }, { 0x0150624a },
+  { 0x0153673e }, { 0x0156d7f6 }, { 0x0157d40e }, { 0x015e13ad },
+  { 0x015e3c6f }, { 0x015eefee }, { 0x0161c58d }, { 0x01622281 },
+  { 0x016a6371 }, { 0x016b3696 }, { 0x016ddda2 }, { 0x016e28bc },
+  { 0x016f2d54 }, { 0x016ff5c8 }, { 0x01706aed }, { 0x01734514 },
+  { 0x0174a135 }, { 0x01751b8e }, { 0x017b2834 }, { 0x017b5585 },
+  { 0x01812202 }, { 0x01821ae1 }, { 0x0185a1da }, { 0x01873f33 },
+  { 0x0188dea2 }, { 0x0189f565 }, { 0x018a9318 }, { 0x018bc823 },
+  { 0x018f20fd }, { 0x019043a4 }, { 0x0191d283 }, { 0x0192ec2b },
+  { 0x01944453 }, { 0x019e3b41 }, { 0x019fc03b }, { 0x01a03ff1 },
+  { 0x01a1b9af }, { 0x01a1fb80 }, { 0x01a2fecb }, { 0x01ace543 },
+  { 0x01ad6a04 }, { 0x01af569a }, { 0x01b272c9 }, { 0x01b81825 },
+  { 0x01ba1029 }, { 0x01bb5715 }, { 0x01bb6a68 }, { 0x01bb9c04 },
+  { 0x01bc51b7 }, { 0x01c1dafc }, { 0x01c27525 }, { 0x01c5acd4 },
+  { 0x01c82bf6 }, { 0x01c84d01 }, { 0x01ccdd7d }, { 0x01cddd8b },
+  { 0x01ce7d89 }, { 0x01d099fc }, { 0x01d0e373 }, { 0x01d1aeff },
+  { 0x01d1d1ea }, { 0x01d1f70e }, { 0x01d3564b }, { 0x01d4a0b6 },
+  { 0x01d5e5df }, { 0x01d9bd60 }, { 0x01dab4f9 }, { 0x01db1b1b },
+  { 0x01dd7a55 }, { 0x01e26a64 }, { 0x01e29d7a }, { 0x01e5c5bd },
+  { 0x01e760fa }, { 0x01e7710b }, { 0x01e854f7 }, { 0x01ef4d11 },
+  { 0x01efb97e }, { 0x01f1de33 }, { 0x01f74964 }, { 0x01f838ea },
+  { 0x01fa3f19 }, { 0x01fa7369 }, { 0x01fa83e3 }, { 0x01fb83e3 },
+  { 0x01fec94a }, { 0x01ff45ca }, { 0x01ff827c }, { 0x01ffc84d },
+  /* tier 2, 10 or more presses */
+  { 0x00019378 }, { 0x0001b58a }, { 0x00033266 }, { 0x00077661 },
+  { 0x00086049 }, { 0x00098ded }, { 0x000a4643 }, { 0x000b0a25 },
+  { 0x000b9e83 }, { 0x000be88f }, { 0x000e7710 }, { 0x00105cae },
+  { 0x0012742e }, { 0x001a16b6 }, { 0x001d5d89 }, { 0x001fc6ac },
+  { 0x001ff63c }, { 0x0021d8c8 }, { 0x0021ebe7 }, { 0x00241564 },
+  { 0x0027423f }, { 0x00293473 }, { 0x0029aced }, { 0x002c4372 },
+  { 0x002d4316 }, { 0x0031d6db }, { 0x0032faa5 }, { 0x003c29a7 },
+  { 0x003d4be9 }, { 0x003df982 }, { 0x003fec78 }, { 0x004006af },
+  { 0x004270f6 }, { 0x0044e18e }, { 0x004a80e7 }, { 0x004de865 },
+  { 0x004e3342 }, { 0x004f322b }, { 0x00511584 }, { 0x0051cb77 },
+  { 0x0051cf24 }, { 0x005627a5 }, { 0x0058b22d }, { 0x005a6643 },
+  { 0x005b1964 }, { 0x005b4d0d }, { 0x005ef9b5 }, { 0x00610b47 },
+  { 0x0061307c }, { 0x006268e0 }, { 0x0062cab4 }, { 0x00656844 },
+  { 0x006a48eb }, { 0x006ac02e }, { 0x006c2733 }, { 0x006fafe4 },
+  { 0x00701d72 }, { 0x007822a5 }, { 0x00786c09 }, { 0x0078c262 },
+  { 0x00799830 }, { 0x007aa8b5 }, { 0x007c2fdd }, { 0x007d7211 },
+  { 0x007fd1c8 }, { 0x008352fb }, { 0x008655f0 }, { 0x00927b4b },
+  { 0x009879e8 }, { 0x0098a5b8 }, { 0x0098c099 }, { 0x00995d14 },
+  { 0x0099fef6 }, { 0x009b0fd5 }, { 0x009be5fe }, { 0x009fc5f1 },
+  { 0x00a0febb }, { 0x00a13a1f }, { 0x00a14294 }, { 0x00a2dddd },
+  { 0x00a30f29 }, { 0x00a3f55e }, { 0x00a4f786 }, { 0x00a5066f },
+  { 0x00a792c0 }, { 0x00a7c529 }, { 0x00abd504 }, { 0x00ac6f51 },
+  { 0x00ae3c08 }, { 0x00af7016 }, { 0x00b09529 }, { 0x00b25a34 },
+  { 0x00b262fd }, { 0x00b6dab3 }, { 0x00b7691b }, { 0x00b9e1b0 },
+  { 0x00c26b0e }, { 0x00c4a089 }, { 0x00c61956 }, { 0x00c67ed9 },
+  { 0x00c83e9b }, { 0x00c8b372 }, { 0x00c9fdf7 }, { 0x00caa75d },
+  { 0x00cd7696 }, { 0x00cff26f }, { 0x00d206cb }, { 0x00d2ce28 },
+  { 0x00d2f4c6 }, { 0x00d7a4b6 }, { 0x00db2abf }, { 0x00dbad94 },
+  { 0x00dbbbd8 }, { 0x00e05230 }, { 0x00e07383 }, { 0x00e2ad34 },
+  { 0x00e4d463 }, { 0x00e5b889 }, { 0x00eb3e7a }, { 0x00eb9693 },
+  { 0x00ecb732 }, { 0x00ed40cc }, { 0x00efca87 }, { 0x00f004ad },
+  { 0x00f159a2 }, { 0x00f56bcd }, { 0x00f97ac4 }, { 0x00fcdd6e },
+  { 0x00fdafff }, { 0x01008181 }, { 0x01067575 }, { 0x010a0308 },
+  { 0x010af28f }, { 0x010eb14a }, { 0x0110a527 }, { 0x0110ff07 },
+  { 0x0113eed1 }, { 0x0118780b }, { 0x01198dad }, { 0x011b25d8 },
+  { 0x011d4403 }, { 0x012237ff }, { 0x01251a97 }, { 0x01264a52 },
+  { 0x012702ff }, { 0x01272776 }, { 0x01287486 }, { 0x0128e5cf },
+  { 0x012f57f1 }, { 0x01319732 }, { 0x01352163 }, { 0x01374ce3 },
+  { 0x0137c111 }, { 0x0138bc3f }, { 0x0138e7ca }, { 0x013b7a44 },
+  { 0x013c4332 }, { 0x01474c1f }, { 0x014ad33f }, { 0x014b190d },
+  { 0x014c8021 }, { 0x014f1a58 }, { 0x014f33c7 }, { 0x014f7a76 },
+  { 0x015101d6 }, { 0x015300ad }, { 0x0156cb5b }, { 0x015791f8 },
+  { 0x01584f50 }, { 0x015a00ff }, { 0x015c370e }, { 0x015fa5a7 },
+  { 0x01632fe2 }, { 0x0164a4cd }, { 0x01650260 }, { 0x0165537e },
+  { 0x0166910d }, { 0x016a9719 }, { 0x016be131 }, { 0x016d4795 },
+  { 0x0172d841 }, { 0x0179fe59 }, { 0x017a2761 }, { 0x017a65a3 },
+  { 0x017c3813 }, { 0x017ea53a }, { 0x017f6dac }, { 0x0185560d },
+  { 0x0185b46e }, { 0x0189e76b }, { 0x018d70e7 }, { 0x018ed373 },
+  { 0x01906a7b }, { 0x01910d3a }, { 0x0191e8d1 }, { 0x01950a20 },
+  { 0x0196161b }, { 0x019837f4 }, { 0x01984120 }, { 0x019863f3 },
+  { 0x01a0af8d }, { 0x01a225b3 }, { 0x01a271af }, { 0x01a4d87a },
+  { 0x01a6703d }, { 0x01a6db54 }, { 0x01a776b8 }, { 0x01a853ae },
+  { 0x01aa41a4 }, { 0x01aaee94 }, { 0x01acc076 }, { 0x01afbe87 },
+  { 0x01b0e7e2 }, { 0x01b12900 }, { 0x01b189d3 }, { 0x01b19c04 },
+  { 0x01b32359 }, { 0x01b386d3 }, { 0x01b54ebd }, { 0x01b650fa },
+  { 0x01b6c070 }, { 0x01b837ad }, { 0x01bb4e46 }, { 0x01bcdbc7 },
+  { 0x01beca40 }, { 0x01bfb001 }, { 0x01bfb509 }, { 0x01c13bdc },
+  { 0x01c22b2e }, { 0x01c2343b }, { 0x01c2549b }, { 0x01c54002 },
+  { 0x01c827d8 }, { 0x01cd31c8 }, { 0x01cdfbd3 }, { 0x01cf0bec },
+  { 0x01d43aaf }, { 0x01d71ec8 }, { 0x01d7be9f }, { 0x01d8c66b },
+  { 0x01da8840 }, { 0x01da9fd3 }, { 0x01db6cf0 }, { 0x01e098db },
+  { 0x01e23f9f }, { 0x01e33666 }, { 0x01e36eb9 }, { 0x01e4b0bf },
+  { 0x01ead79a }, { 0x01f0494e }, { 0x01f9c25e }, { 0x01fcc370 },
+  { 0x01fd3680 }, { 0x01fd591b }, { 0x01fedd14 }, { 0x01ff408f },
+  /* tier 3, 13 or more presses */
+  { 0x000197f9 }, { 0x00043394 }, { 0x0004935c }, { 0x0007e639 },
+  { 0x000b91c0 }, { 0x000e51cb }, { 0x000efb0f }, { 0x00123209 },
+  { 0x00134808 }, { 0x001366f8 }, { 0x0016bb61 }, { 0x001898ae },
+  { 0x00192eb5 }, { 0x001a367a }, { 0x001d3320 }, { 0x001ecafa },
+  { 0x0022daa6 }, { 0x0025e5b8 }, { 0x0026c36d }, { 0x0026c9ef },
+  { 0x0026f021 }, { 0x002a8427 }, { 0x002a9b29 }, { 0x003d41ef },
+  { 0x003f0c8d }, { 0x003fbde8 }, { 0x003fcdef }, { 0x0040393b },
+  { 0x0046eb37 }, { 0x004ac95c }, { 0x004b54bf }, { 0x004c7fcd },
+  { 0x00513344 }, { 0x0052f727 }, { 0x00533c7b }, { 0x00559fb4 },
+  { 0x00597831 }, { 0x005a10dd }, { 0x005b13de }, { 0x005d4988 },
+  { 0x00611270 }, { 0x00615bda }, { 0x0062800b }, { 0x00631339 },
+  { 0x00687f41 }, { 0x00689943 }, { 0x00695a9e }, { 0x006a04f8 },
+  { 0x006b726b }, { 0x006b845b }, { 0x006c453d }, { 0x006d9920 },
+  { 0x0071df0f }, { 0x0072583b }, { 0x00749aa8 }, { 0x0075307a },
+  { 0x0076e6f0 }, { 0x0077a265 }, { 0x0079d250 }, { 0x0080f958 },
+  { 0x0081acf5 }, { 0x0084f1e1 }, { 0x0085fc65 }, { 0x008699ea },
+  { 0x008724d3 }, { 0x0088e239 }, { 0x0089f94a }, { 0x00915348 },
+  { 0x0095e88b }, { 0x009733f0 }, { 0x0097df6b }, { 0x009ab41b },
+  { 0x009c0dd8 }, { 0x009ced43 }, { 0x009db37a }, { 0x009f4c01 },
+  { 0x00a0de61 }, { 0x00a1cee2 }, { 0x00a2a6f5 }, { 0x00a8932a },
+  { 0x00a8e997 }, { 0x00b1ae15 }, { 0x00b20929 }, { 0x00b2fb4d },
+  { 0x00b375e0 }, { 0x00b51006 }, { 0x00b8cac6 }, { 0x00b95b34 },
+  { 0x00b9fdcf }, { 0x00bb2910 }, { 0x00bcc619 }, { 0x00bce117 },
+  { 0x00bdfd01 }, { 0x00be79d1 }, { 0x00c147f4 }, { 0x00c42ca9 },
+  { 0x00c4d218 }, { 0x00c5a96c }, { 0x00c61929 }, { 0x00c7d759 },
+  { 0x00c9ae69 }, { 0x00cc0900 }, { 0x00cc4bb0 }, { 0x00d06ad3 },
+  { 0x00d2185d }, { 0x00d89b8f }, { 0x00d94ebe }, { 0x00d95ea5 },
+  { 0x00d98320 }, { 0x00dd04c2 }, { 0x00dddfc5 }, { 0x00de93fc },
+  { 0x00e047e0 }, { 0x00e1c0e5 }, { 0x00e5c2a1 }, { 0x00e7797a },
+  { 0x00ec6af0 }, { 0x00ecdf6c }, { 0x00ece263 }, { 0x00ee27c9 },
+  { 0x00eedf01 }, { 0x00f052ca }, { 0x00f430ed }, { 0x00f5826c },
+  { 0x00f5bc91 }, { 0x00f65c09 }, { 0x00f74e1b }, { 0x00f998bc },
+  { 0x00fb4794 }, { 0x00fe41f1 }, { 0x0103115e }, { 0x0105230d },
+  { 0x010577d8 }, { 0x010665c3 }, { 0x010941df }, { 0x010a7041 },
+  { 0x010ff612 }, { 0x01116a88 }, { 0x01150f31 }, { 0x01154b20 },
+  { 0x01188c16 }, { 0x011946bb }, { 0x01197888 }, { 0x0119d9fb },
+  { 0x011c5faf }, { 0x011c8b33 }, { 0x011cdb6d }, { 0x011edbf6 },
+  { 0x0124a23e }, { 0x0126e510 }, { 0x0128bce1 }, { 0x012a89af },
+  { 0x012d047d }, { 0x0130aad0 }, { 0x0130ee5e }, { 0x0133e80a },
+  { 0x01341598 }, { 0x0135013a }, { 0x0137fbb8 }, { 0x014474ea },
+  { 0x0146fd97 }, { 0x01477193 }, { 0x01495928 }, { 0x014b28dd },
+  { 0x014e93b9 }, { 0x014eaddb }, { 0x01502286 }, { 0x01504041 },
+  { 0x015108a6 }, { 0x0155c81c }, { 0x01572da5 }, { 0x0158901f },
+  { 0x015d515e }, { 0x016075f4 }, { 0x0161412c }, { 0x016a7768 },
+  { 0x016db7f8 }, { 0x016e1e36 }, { 0x016f45bb }, { 0x01719317 },
+  { 0x0173d446 }, { 0x01743dff }, { 0x0174bd89 }, { 0x0174f8e0 },
+  { 0x0175354b }, { 0x0176ce3f }, { 0x0178c3ea }, { 0x017a0844 },
+  { 0x017d3f27 }, { 0x017fd023 }, { 0x01855abb }, { 0x0186275f },
+  { 0x0186c001 }, { 0x01883dc1 }, { 0x018dace6 }, { 0x018e0036 },
+  { 0x018fdf9e }, { 0x018ff86c }, { 0x01909213 }, { 0x01915380 },
+  { 0x01992565 }, { 0x019ac957 }, { 0x019b48f3 }, { 0x019cbf76 },
+  { 0x019cd198 }, { 0x019d41f8 }, { 0x01a7de8e }, { 0x01aed9be },
+  { 0x01b916fe }, { 0x01ba840b }, { 0x01bb2d2c }, { 0x01bc691a },
+  { 0x01bd7ebb }, { 0x01bdf537 }, { 0x01bee11f }, { 0x01bfab75 },
+  { 0x01c2f95e }, { 0x01c34707 }, { 0x01c6bb91 }, { 0x01c7d9c3 },
+  { 0x01c902f6 }, { 0x01c9abb8 }, { 0x01cd11f8 }, { 0x01ce6694 },
+  { 0x01ce844b }, { 0x01cf29e7 }, { 0x01cf6387 }, { 0x01d13dee },
+  { 0x01d2e29a }, { 0x01d3218e }, { 0x01d39404 }, { 0x01d5280c },
+  { 0x01d71583 }, { 0x01d8f763 }, { 0x01d8f9f8 }, { 0x01da5080 },
+  { 0x01e00c8c }, { 0x01e3af6a }, { 0x01e42355 }, { 0x01e81208 },
+  { 0x01e868b2 }, { 0x01e8fb71 }, { 0x01eac167 }, { 0x01eb6008 },
+  { 0x01edee7e }, { 0x01f02769 }, { 0x01f23e93 }, { 0x01f71866 },
+  { 0x01f96a93 }, { 0x01fae47d }, { 0x01fb0df5 }, { 0x01fb7546 },
+  { 0x01fba346 }, { 0x01fd4f82 }, { 0x01fe5611 }, { 0x01ff9fe9 },
+};
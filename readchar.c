@@ -8,9 +8,68 @@
 #include <410_reqs.h>
 #include <fifo_buffer.h>
 #include <keyhelp.h>
+#include <readchar.h>
+#include <cpu.h>
+#include <deferred.h>
+#include <clock.h>
 #include <x86/proc_reg.h>
 
 
+/* decoded key presses, only touched outside interrupt context */
+static key_event_t events[EVENT_QUEUE_SIZE];
+static unsigned int ev_head = 0;
+static unsigned int ev_tail = 0;
+
+/** @brief decodes every pending scancode into the event queue
+ *
+ *  Takes no more scancodes than there is room for events, each
+ *  scancode makes at most one event, so none are lost. Break codes
+ *  and modifier keys only update the keyhelp state.
+ *
+ *  @return the number of events added
+ */
+int
+decode_scancodes(void)
+{
+  unsigned char codes[EVENT_QUEUE_SIZE];
+  int room = EVENT_QUEUE_SIZE - (ev_head - ev_tail);
+  int n = dequeue_n(codes, room);
+  unsigned long long now = clock_ns();
+  unsigned int start = ev_head;
+  int i;
+
+  for(i = 0; i < n; i++)
+  {
+    kh_type augchar = process_scancode(codes[i]);
+    if(KH_HASDATA(augchar) && KH_ISMAKE(augchar))
+    {
+      key_event_t *ev = &events[ev_head++ & EVENT_QUEUE_MASK];
+      ev->time = now;
+      ev->ch = KH_GETCHAR(augchar);
+    }
+  }
+  return ev_head - start;
+}
+
+/** @brief takes up to max decoded key presses
+ *
+ *  @param out where the events are written, oldest first
+ *  @param max the most events to take
+ *  @return the number of events taken
+ */
+int
+next_events(key_event_t *out, int max)
+{
+  int n = 0;
+
+  if(ev_head == ev_tail)
+    decode_scancodes();
+
+  while(n < max && ev_tail != ev_head)
+    out[n++] = events[ev_tail++ & EVENT_QUEUE_MASK];
+  return n;
+}
+
 /** @brief function read a character from console
  *
  *  @return character code if character in queue, -1 otherwise 
@@ -18,10 +77,36 @@
 int
 readchar(void)
 {
-  int scancode = dequeue_char();
-  kh_type augchar = process_scancode(scancode);
-  
-  if(KH_HASDATA(augchar) && KH_ISMAKE(augchar))
-    return KH_GETCHAR(augchar);
+  key_event_t ev;
+  if(next_events(&ev, 1))
+    return ev.ch;
   return -1;
 }
+
+/** @brief waits for the next interrupt and takes the key presses it brought
+ *
+ *  If no key press or deferred work is pending the processor is halted
+ *  with interrupts enabled, so it idles until the timer or keyboard
+ *  interrupt fires.
+ *  The check and the halt are done with interrupts disabled, so a key
+ *  arriving in between cannot be missed.
+ *
+ *  @param out where the events are written, oldest first
+ *  @param max the most events to take
+ *  @return the number of events taken, 0 if woken by another interrupt
+ */
+int
+wait_for_event(key_event_t *out, int max)
+{
+  int n = next_events(out, max);
+  if(n)
+    return n;
+
+  disable_interrupts();
+  if(head == tail && !deferred_pending)
+    halt_for_interrupt();
+  else
+    enable_interrupts();
+
+  return next_events(out, max);
+}
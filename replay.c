@@ -0,0 +1,173 @@
+/** @file replay.c
+ * 
+ *  @brief Records the input of a game for replay
+ *  
+ *  @author Heather Arthur (harthur) 
+ *  @bug Screens showing measured times (interrupt statistics and the
+ *       trace) do not replay the same
+ **/
+
+#include <replay.h>
+#include <board.h>
+#include <serial.h>
+#include <timer.h>
+#include <x86/proc_reg.h>
+
+unsigned char replay_log[REPLAY_LOG_SIZE];
+unsigned int replay_len = 0;
+unsigned int replay_dropped = 0;
+int (*replay_seed_source)(unsigned int *seed) = 0;
+
+/* the tick count of the last REC_TICK */
+static unsigned int last_tick = 0;
+
+/** @brief appends a record to the log
+ *
+ *  The handlers run through trap gates with interrupts on, so the
+ *  timer can interrupt the keyboard handler. Interrupts are turned
+ *  off while appending so records never interleave.
+ *
+ *  @param rec the record
+ *  @param len the length of the record
+ *  @return Void
+ */
+static void append(const unsigned char *rec, int len)
+{
+  int i;
+
+  disable_interrupts();
+  if(replay_len + len > REPLAY_LOG_SIZE)
+    replay_dropped++;
+  else
+    for(i = 0; i < len; i++)
+      replay_log[replay_len++] = rec[i];
+  enable_interrupts();
+}
+
+/** @brief writes a number as LEB128
+ *
+ *  @param out where the at most REPLAY_NUM_MAX bytes are written
+ *  @param n the number
+ *  @return the number of bytes written
+ */
+static int put_num(unsigned char *out, unsigned int n)
+{
+  int len = 0;
+
+  do
+  {
+    out[len++] = (n & 0x7F) | (n > 0x7F ? 0x80 : 0);
+    n >>= 7;
+  } while(n);
+  return len;
+}
+
+/** @brief records a scancode queued by the keyboard handler
+ *
+ *  @param code the scancode
+ *  @return Void
+ */
+void replay_key(unsigned char code)
+{
+  unsigned char rec[2] = { REC_KEY, code };
+  append(rec, 2);
+}
+
+/** @brief records the tick count passed to the tickback
+ *
+ *  Only called from the timer handler, which is not reentrant, so
+ *  last_tick needs no lock
+ *
+ *  @param numTicks the number of ticks since startup
+ *  @return Void
+ */
+void replay_tick(unsigned int numTicks)
+{
+  unsigned char rec[1 + REPLAY_NUM_MAX];
+
+  rec[0] = REC_TICK;
+  append(rec, 1 + put_num(rec + 1, numTicks - last_tick));
+  last_tick = numTicks;
+}
+
+/** @brief records the seed of a new grid
+ *
+ *  When a log is being played the recorded seed is used instead, so
+ *  the grid is the same whenever the ticks around it were replayed
+ *
+ *  @param seed the seed taken from the clock
+ *  @return the seed to use
+ */
+unsigned int replay_seed(unsigned int seed)
+{
+  unsigned char rec[1 + REPLAY_NUM_MAX];
+
+  if(replay_seed_source)
+    replay_seed_source(&seed);
+
+  rec[0] = REC_SEED;
+  append(rec, 1 + put_num(rec + 1, seed));
+  return seed;
+}
+
+/** @brief writes the header of a log
+ *
+ *  @param hdr where the REPLAY_HDR_SIZE bytes are written
+ *  @param len the length of the records that follow
+ *  @return Void
+ */
+void replay_header(unsigned char *hdr, unsigned int len)
+{
+  hdr[0] = REPLAY_MAGIC[0];
+  hdr[1] = REPLAY_MAGIC[1];
+  hdr[2] = REPLAY_MAGIC[2];
+  hdr[3] = REPLAY_VERSION;
+  hdr[4] = GRID_ROWS;
+  hdr[5] = GRID_COLS;
+  hdr[6] = tick_hz & 0xFF;
+  hdr[7] = tick_hz >> 8;
+  hdr[8] = len & 0xFF;
+  hdr[9] = (len >> 8) & 0xFF;
+  hdr[10] = (len >> 16) & 0xFF;
+  hdr[11] = len >> 24;
+}
+
+/** @brief checks that a log was recorded by this build
+ *
+ *  The grid size must match, and the tick rate is set to the one
+ *  recorded
+ *
+ *  @param hdr the header of the log
+ *  @param len where the length of the records is written
+ *  @return 0 if the log can be replayed, -1 otherwise
+ */
+int replay_check_header(const unsigned char *hdr, unsigned int *len)
+{
+  if(hdr[0] != REPLAY_MAGIC[0] || hdr[1] != REPLAY_MAGIC[1] ||
+     hdr[2] != REPLAY_MAGIC[2] || hdr[3] != REPLAY_VERSION ||
+     hdr[4] != GRID_ROWS || hdr[5] != GRID_COLS)
+    return -1;
+
+  if(timer_set_hz(hdr[6] | (hdr[7] << 8)) < 0)
+    return -1;
+
+  *len = hdr[8] | (hdr[9] << 8) | (hdr[10] << 16) |
+         ((unsigned int)hdr[11] << 24);
+  return 0;
+}
+
+/** @brief writes the log recorded so far to the serial port
+ *
+ *  The bytes are sent as they are, a header then the records
+ *
+ *  @return Void
+ */
+void replay_dump_serial()
+{
+  unsigned char hdr[REPLAY_HDR_SIZE];
+  unsigned int len = replay_len;
+
+  replay_header(hdr, len);
+  serial_write((const char *)hdr, REPLAY_HDR_SIZE);
+  serial_write((const char *)replay_log, len);
+}
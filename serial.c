@@ -0,0 +1,61 @@
+/** @file serial.c
+ * 
+ *  @brief A polled driver for the first serial port
+ *
+ *  Output only, with the port's interrupts left off. Used to get
+ *  traces and logs off the machine without a debugger.
+ *  
+ *  @author Heather Arthur (harthur) 
+ *  @bug None known
+ **/
+
+#include <serial.h>
+#include <x86/pio.h>
+
+/* whether serial_init has run */
+static int serial_ready = 0;
+
+/** @brief sets the port to 115200 baud 8N1 with no interrupts
+ *
+ *  @param Void
+ *  @return Void
+ */
+void serial_init()
+{
+  outb(COM1_BASE + SERIAL_IER, 0);
+  outb(COM1_BASE + SERIAL_LCR, SERIAL_LCR_DLAB);
+  outb(COM1_BASE + SERIAL_DATA, SERIAL_DIVISOR & 0xFF);
+  outb(COM1_BASE + SERIAL_IER, SERIAL_DIVISOR >> 8);
+  outb(COM1_BASE + SERIAL_LCR, SERIAL_LCR_8N1);
+  outb(COM1_BASE + SERIAL_FCR, SERIAL_FCR_ON);
+  outb(COM1_BASE + SERIAL_MCR, SERIAL_MCR_ON);
+  serial_ready = 1;
+}
+
+/** @brief sends a character, waiting for room in the transmitter
+ *
+ *  @param ch the character to send
+ *  @return Void
+ */
+void serial_putc(char ch)
+{
+  if(!serial_ready)
+    serial_init();
+
+  while(!(inb(COM1_BASE + SERIAL_LSR) & SERIAL_LSR_THRE))
+    ;
+  outb(COM1_BASE + SERIAL_DATA, ch);
+}
+
+/** @brief sends len characters of s
+ *
+ *  @param s the characters to send
+ *  @param len the number of characters
+ *  @return Void
+ */
+void serial_write(const char *s, int len)
+{
+  int i;
+  for(i = 0; i < len; i++)
+    serial_putc(s[i]);
+}
@@ -0,0 +1,169 @@
+/** @file solver.c
+ *
+ *  @brief Solves any board with the fewest presses
+ *
+ *  solver_init() runs Gauss-Jordan elimination on [A | I] once. The
+ *  rows of I that end up beside a zero row of A span the null space
+ *  of A (A is symmetric, so its left and right null spaces are the
+ *  same). A board is solvable exactly when it has even overlap with
+ *  each of them, and every solution is one particular solution plus
+ *  a combination of them. For the 5x5 grid the null space has
+ *  dimension 2, so the minimal solution is the smallest of four
+ *  candidates.
+ *
+ *  @author Heather Arthur (harthur)
+ *  @bug None known
+ **/
+
+#include <board.h>
+#include <solver.h>
+
+/* solve_tab[k][v] is the particular solution of the board whose
+ * k-th byte is v and all other bits are clear */
+static board_t solve_tab[SOLVE_CHUNKS][256];
+
+/* a basis of the null space of A */
+static board_t null_basis[NULL_MAX];
+static int null_dim;
+
+/* the boards reachable by pressing a combination of null_basis,
+ * they do not change the board */
+static board_t null_space[1 << NULL_MAX];
+
+/** @brief precomputes the solver tables
+ *
+ *  Must be called after board_init() and before any other solver
+ *  function
+ *
+ *  @param Void
+ *  @return Void
+ */
+void solver_init()
+{
+  static board_t a[GRID_SQUARES], e[GRID_SQUARES];
+  static board_t cols[GRID_SQUARES];
+  int pivot[GRID_SQUARES];
+  int i, j, k, rank = 0;
+
+  for(i = 0; i < GRID_SQUARES; i++)
+  {
+    a[i] = toggle_masks[i];
+    e[i] = board_bit(i);
+  }
+
+  /* reduce a to row echelon form, applying the same steps to e */
+  for(j = 0; j < GRID_SQUARES; j++)
+  {
+    for(i = rank; i < GRID_SQUARES && !board_test(a[i], j); i++)
+      ;
+    if(i == GRID_SQUARES)
+      continue;
+
+    board_t t = a[i]; a[i] = a[rank]; a[rank] = t;
+    t = e[i]; e[i] = e[rank]; e[rank] = t;
+
+    for(i = 0; i < GRID_SQUARES; i++)
+      if(i != rank && board_test(a[i], j))
+      {
+        a[i] = board_xor(a[i], a[rank]);
+        e[i] = board_xor(e[i], e[rank]);
+      }
+    pivot[rank++] = j;
+  }
+
+  /* pressing pivot[i] is needed when the board overlaps e[i] oddly,
+   * so lit square j contributes every such pivot to the solution */
+  for(j = 0; j < GRID_SQUARES; j++)
+  {
+    cols[j] = board_zero();
+    for(i = 0; i < rank; i++)
+      if(board_test(e[i], j))
+        cols[j] = board_xor(cols[j], board_bit(pivot[i]));
+  }
+
+  for(k = 0; k < SOLVE_CHUNKS; k++)
+    for(i = 0; i < 256; i++)
+    {
+      board_t x = board_zero();
+      for(j = 0; j < 8 && k*8 + j < GRID_SQUARES; j++)
+        if(i & (1 << j))
+          x = board_xor(x, cols[k*8 + j]);
+      solve_tab[k][i] = x;
+    }
+
+  null_dim = GRID_SQUARES - rank;
+  for(i = 0; i < null_dim; i++)
+    null_basis[i] = e[rank + i];
+
+  /* walk every combination of the basis */
+  null_space[0] = board_zero();
+  for(i = 1; i < (1 << null_dim); i++)
+  {
+    for(k = 0; !(i & (1 << k)); k++)
+      ;
+    null_space[i] = board_xor(null_space[i & (i - 1)], null_basis[k]);
+  }
+}
+
+/** @brief returns whether a board can be turned off
+ *
+ *  @param board the board to check
+ *  @return non-zero if some set of presses solves board
+ */
+int solvable(board_t board)
+{
+  int i;
+  for(i = 0; i < null_dim; i++)
+    if(board_count(board_and(board, null_basis[i])) & 1)
+      return 0;
+  return 1;
+}
+
+/** @brief returns the smallest set of presses equivalent to presses
+ *
+ *  Adding a null space vector to a solution gives another solution,
+ *  so the result solves exactly the same boards as presses
+ *
+ *  @param presses any solution of a board
+ *  @return the solution of that board with the fewest presses
+ */
+board_t solver_minimize(board_t presses)
+{
+  board_t best = presses;
+  int best_count = board_count(presses);
+  int i;
+
+  for(i = 1; i < (1 << null_dim); i++)
+  {
+    board_t x = board_xor(presses, null_space[i]);
+    int count = board_count(x);
+    if(count < best_count)
+    {
+      best = x;
+      best_count = count;
+    }
+  }
+  return best;
+}
+
+/** @brief finds the minimal solution of a board
+ *
+ *  @param board the board to solve
+ *  @param presses where the squares to press are written, if non-null
+ *  @return the number of presses needed, -1 if board is unsolvable
+ */
+int solve(board_t board, board_t *presses)
+{
+  if(!solvable(board))
+    return -1;
+
+  board_t x = board_zero();
+  int k;
+  for(k = 0; k < SOLVE_CHUNKS; k++)
+    x = board_xor(x, solve_tab[k][board_byte(board, k)]);
+
+  x = solver_minimize(x);
+  if(presses)
+    *presses = x;
+  return board_count(x);
+}
@@ -5,22 +5,41 @@
  **/
 
 #include <410_reqs.h>
-#include <paint_screen.h>
+#include <deferred.h>
+#include <timer.h>
 #include <time.h>
-#include <stdio.h>
+
+unsigned int game_time = 0;
+unsigned int total_time = 0;
+int can_tick = 0;
+
+/* the tick count passed to the last call */
+static unsigned int last_ticks = 0;
 
 /**@brief Tick function, to be called by the timer interrupt handler
  * 
- * @param numTicks the number of ticks since last interrupt 
+ * Runs in interrupt context, so it never draws. When the game time
+ * reaches a new second it posts DEFER_TIME for the main loop. In
+ * tickless mode the next interrupt is only needed at that second.
+ *
+ * @param numTicks the number of ticks since startup
  *
  **/
 void tick(unsigned int numTicks)
 {
+  unsigned int elapsed = numTicks - last_ticks;
+  last_ticks = numTicks;
+
   total_time = numTicks;
   if(can_tick)
   {
-    game_time++;
-    if(game_time % 100 == 0)
-      update_time(game_time);
+    unsigned int before = game_time;
+    game_time += elapsed;
+    if(game_time / tick_hz != before / tick_hz)
+      defer_post(DEFER_TIME);
+
+    timer_deadline(numTicks + tick_hz - game_time % tick_hz);
   }
+  else
+    timer_deadline(NO_DEADLINE);
 }
@@ -3,17 +3,74 @@
  *  @brief The timer interrupt handler function
  *
  *  @author Heather Arthur 
- *  @bug None known
+ *  @bug In tickless mode the time spent between the interrupt and
+ *       reprogramming the PIT is not counted, so time runs slightly slow
  **/
 
 #include <410_reqs.h>
 #include <interrupts.h>
+#include <timer_defines.h>
 #include <x86/pio.h>
 #include <tickback_addr.h>
-#include <kerndebug.h>
+#include <pack_address.h>
+#include <timer.h>
+#include <irq_stats.h>
+#include <trace.h>
+#include <replay.h>
 
 /** brief the current number of ticks since startup */
-unsigned int ticks = 0;
+volatile unsigned int ticks = 0;
+
+unsigned int tick_hz = TICK_HZ;
+
+/* the function run on every tick */
+void (*tickback_addr)(unsigned int) = 0;
+
+/* the PIT count of one tick */
+static unsigned int tick_count = TIMER_RATE / TICK_HZ;
+/* whether the PIT is run one shot at a time */
+static int tickless = 0;
+/* the ticks covered by the PIT period now running */
+static unsigned int shot_ticks = 1;
+/* the tick the next interrupt is wanted by, in tickless mode */
+static unsigned int deadline = NO_DEADLINE;
+
+/** @brief programs the PIT
+ *
+ *  @param mode the PIT mode command
+ *  @param count the PIT count of the period
+ *  @return Void
+ */
+static void pit_program(int mode, unsigned int count)
+{
+  outb(TIMER_MODE_IO_PORT, mode);
+  outb(TIMER_PERIOD_IO_PORT, LOWER8(count));
+  outb(TIMER_PERIOD_IO_PORT, UPPER8(count));
+}
+
+/** @brief starts a one shot period ending at the deadline
+ *
+ *  The period is at least one tick and at most as many whole ticks
+ *  as fit in the PIT counter
+ *
+ *  @return Void
+ */
+static void next_shot()
+{
+  unsigned int n = PIT_MAX_COUNT / tick_count;
+
+  if(deadline != NO_DEADLINE)
+  {
+    int left = (int)(deadline - ticks);
+    if(left < 1)
+      n = 1;
+    else if((unsigned int)left < n)
+      n = left;
+  }
+
+  shot_ticks = n;
+  pit_program(PIT_ONE_SHOT, n * tick_count);
+}
 
 /** @brief The timer handler
  *  
@@ -25,10 +82,82 @@ unsigned int ticks = 0;
  */
 void timer_handler()
 {
-  MAGIC_BREAK;
-  ticks++;
+  IRQ_ENTER(IRQ_TIMER);
+  ticks += shot_ticks;
+  TRACE(TR_TIMER, ticks, shot_ticks);
   if(tickback_addr)
+  {
+    REPLAY_TICK(ticks);
     tickback_addr(ticks);
+  }
 
+  if(tickless)
+    next_shot();
+
+  /* finish the stats first, the EOI lets this IRQ nest on a trap gate */
+  IRQ_EXIT(IRQ_TIMER);
   outb(INT_CTL_REG, INT_CTL_DONE);
 }
+
+/** @brief sets the number of timer ticks per second
+ *
+ *  Should be called before time is counted, ticks already counted
+ *  are not rescaled
+ *
+ *  @param hz the new tick rate
+ *  @return 0 on success, -1 if the PIT cannot run at hz
+ */
+int timer_set_hz(unsigned int hz)
+{
+  if(hz == 0 || TIMER_RATE / hz == 0 || TIMER_RATE / hz > PIT_MAX_COUNT)
+    return -1;
+
+  tick_hz = hz;
+  tick_count = TIMER_RATE / hz;
+  shot_ticks = 1;
+
+  if(tickless)
+    next_shot();
+  else
+    pit_program(TIMER_SQUARE_WAVE, tick_count);
+  return 0;
+}
+
+/** @brief switches between periodic and tickless mode
+ *
+ *  @param enable non-zero to only interrupt by the next deadline
+ *  @return Void
+ */
+void timer_tickless(int enable)
+{
+  tickless = enable;
+  shot_ticks = 1;
+
+  if(tickless)
+    next_shot();
+  else
+    pit_program(TIMER_SQUARE_WAVE, tick_count);
+}
+
+/** @brief tells whether the timer is in tickless mode
+ *
+ *  @return non-zero in tickless mode, 0 in periodic mode
+ */
+int timer_is_tickless()
+{
+  return tickless;
+}
+
+/** @brief asks for a timer interrupt by a tick
+ *
+ *  Only used in tickless mode, where it replaces the previous
+ *  deadline. It takes effect from the next interrupt, so it is meant
+ *  to be called from the tickback.
+ *
+ *  @param tick the tick to interrupt by, NO_DEADLINE for none
+ *  @return Void
+ */
+void timer_deadline(unsigned int tick)
+{
+  deadline = tick;
+}
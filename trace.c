@@ -0,0 +1,117 @@
+/** @file trace.c
+ * 
+ *  @brief Reads back and dumps the event trace rings
+ *  
+ *  @author Heather Arthur (harthur) 
+ *  @bug None known
+ **/
+
+#include <trace.h>
+#include <serial.h>
+#include <clock.h>
+#include <stdio.h>
+#include <x86/proc_reg.h>
+
+/* the longest line of a serial dump */
+#define DUMP_LINE 64
+
+trace_ring_t trace_rings[TR_TYPES];
+
+/* the names of the events, indexed by TR_ number */
+static const char *trace_names[TR_TYPES] = {
+  "timer", "key", "char", "paint", "flush"
+};
+
+/** @brief returns the name of an event
+ *
+ *  @param id the TR_ event
+ *  @return a short name for the event
+ */
+const char *trace_name(int id)
+{
+  if(id < 0 || id >= TR_TYPES)
+    return "?";
+  return trace_names[id];
+}
+
+/** @brief copies the most recent records of all events, in time order
+ *
+ *  Merges the rings newest first with interrupts off, so the
+ *  interrupt handlers cannot write a ring while it is read
+ *
+ *  @param out where the records are written, oldest first
+ *  @param max the most records to copy
+ *  @return the number of records copied
+ */
+int trace_collect(trace_rec_t *out, int max)
+{
+  unsigned int avail[TR_TYPES], used[TR_TYPES];
+  int i, n = 0;
+
+  disable_interrupts();
+
+  for(i = 0; i < TR_TYPES; i++)
+  {
+    avail[i] = trace_rings[i].next;
+    if(avail[i] > TRACE_RING_SIZE)
+      avail[i] = TRACE_RING_SIZE;
+    used[i] = 0;
+  }
+
+  /* take the newest record left in any ring, max times */
+  while(n < max)
+  {
+    trace_rec_t *newest = 0;
+    int from = 0;
+
+    for(i = 0; i < TR_TYPES; i++)
+      if(used[i] < avail[i])
+      {
+	trace_ring_t *ring = &trace_rings[i];
+	trace_rec_t *rec = &ring->rec[(ring->next - 1 - used[i]) & TRACE_RING_MASK];
+	if(!newest || rec->time > newest->time)
+	{
+	  newest = rec;
+	  from = i;
+	}
+      }
+
+    if(!newest)
+      break;
+    used[from]++;
+    out[n++] = *newest;
+  }
+
+  enable_interrupts();
+
+  /* put the oldest first */
+  for(i = 0; i < n / 2; i++)
+  {
+    trace_rec_t t = out[i];
+    out[i] = out[n - 1 - i];
+    out[n - 1 - i] = t;
+  }
+  return n;
+}
+
+/** @brief writes every record in the trace rings to the serial port
+ *
+ *  One line per record, oldest first, with the time in microseconds
+ *  since the oldest record
+ *
+ *  @return Void
+ */
+void trace_dump_serial()
+{
+  static trace_rec_t recs[TR_TYPES * TRACE_RING_SIZE];
+  char line[DUMP_LINE];
+  int i, n = trace_collect(recs, TR_TYPES * TRACE_RING_SIZE);
+
+  for(i = 0; i < n; i++)
+  {
+    int len = snprintf(line, sizeof(line), "%10u us %-6s %u %u\r\n",
+		       cycles_to_us(recs[i].time - recs[0].time),
+		       trace_name(recs[i].id), recs[i].arg0, recs[i].arg1);
+    serial_write(line, len);
+  }
+}